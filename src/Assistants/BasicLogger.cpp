@@ -76,7 +76,11 @@ void BasicLogger::writeLogFile(
 		}
 	}
 
-	std::cout << ++counter << " :: " << message << std::endl;
+	const std::lock_guard lock{ logLock };
+
+	if (echoConsole) {
+		std::cout << ++counter << " :: " << message << std::endl;
+	} else { ++counter; }
 	std::ofstream logFile(logFilePath, std::ios::app);
 	if (!logFile.is_open()) {
 		throw PathException("Unable to access log file: ", logFilePath);
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <filesystem>
 
@@ -23,6 +24,9 @@ class BasicLogger final {
 
 	std::size_t cStd{}, cDbg{};
 
+	mutable std::mutex logLock{};
+	bool echoConsole{ true };
+
 	void createDirectory(
 		const std::string&,
 		const std::filesystem::path&,
@@ -43,6 +47,8 @@ public:
 	void setStdLogFile(const std::string&, const std::filesystem::path&);
 	void setDbgLogFile(const std::string&, const std::filesystem::path&);
 
+	void setConsoleEcho(const bool state) noexcept { echoConsole = state; }
+
 	void stdLogOut(const std::string&);
 	void dbgLogOut(const std::string&);
 };
@@ -0,0 +1,62 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <cstring>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+#endif
+
+#include "JitArena.hpp"
+
+JitArena::JitArena(const std::size_t size) noexcept {
+#ifdef _WIN32
+	void* base{ VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READ) };
+	if (!base) { return; }
+#else
+	void* base{ mmap(nullptr, size, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+	if (base == MAP_FAILED) { return; }
+#endif
+	mBase = static_cast<std::uint8_t*>(base);
+	mSize = size;
+}
+
+JitArena::~JitArena() noexcept {
+	if (!mBase) { return; }
+#ifdef _WIN32
+	VirtualFree(mBase, 0, MEM_RELEASE);
+#else
+	munmap(mBase, mSize);
+#endif
+}
+
+bool JitArena::protect(const bool writable) noexcept {
+#ifdef _WIN32
+	DWORD previous;
+	return VirtualProtect(mBase, mSize, writable ? PAGE_READWRITE : PAGE_EXECUTE_READ, &previous);
+#else
+	return !mprotect(mBase, mSize, writable ? PROT_READ | PROT_WRITE : PROT_READ | PROT_EXEC);
+#endif
+}
+
+void* JitArena::commit(const std::span<const std::uint8_t> code) noexcept {
+	constexpr std::size_t align{ 16 };
+
+	if (!mBase || mUsed + code.size() > mSize) { return nullptr; }
+	if (!protect(true)) { return nullptr; }
+
+	auto* entry{ mBase + mUsed };
+	std::memcpy(entry, code.data(), code.size());
+	mUsed = mUsed + code.size() + align - 1 & ~(align - 1);
+
+	if (!protect(false)) { return nullptr; }
+#ifdef _WIN32
+	FlushInstructionCache(GetCurrentProcess(), entry, code.size());
+#endif
+	return entry;
+}
@@ -0,0 +1,40 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <span>
+#include <cstddef>
+#include <cstdint>
+
+/*
+	Bump allocator over a block of executable host memory for generated
+	code. The memory is only writable while a block is being committed,
+	and is otherwise kept read-execute.
+*/
+
+class JitArena final {
+	std::uint8_t* mBase{};
+	std::size_t   mSize{};
+	std::size_t   mUsed{};
+
+	bool protect(bool writable) noexcept;
+
+public:
+	explicit JitArena(std::size_t size = 1 << 20) noexcept;
+	~JitArena() noexcept;
+
+	JitArena(const JitArena&) = delete;
+	JitArena& operator=(const JitArena&) = delete;
+
+	[[nodiscard]] bool valid() const noexcept { return mBase; }
+
+	// Copy code into the arena, returns its entry point or nullptr if full
+	[[nodiscard]] void* commit(std::span<const std::uint8_t> code) noexcept;
+
+	// Discard all committed code
+	void reset() noexcept { mUsed = 0; }
+};
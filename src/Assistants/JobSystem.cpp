@@ -0,0 +1,154 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "JobSystem.hpp"
+
+#include <chrono>
+#include <algorithm>
+
+/*==================================================================*/
+	#pragma region JobSystem Class
+/*==================================================================*/
+
+JobSystem& bjs::jobs{ JobSystem::create() };
+
+// which pool the current thread belongs to, and its worker slot there
+static thread_local const JobSystem* sPool{};
+static thread_local std::size_t      sSlot{};
+
+JobSystem::JobSystem(const std::size_t threads) {
+	for (std::size_t i{}; i <= threads; ++i) {
+		mWorkers.push_back(std::make_unique<Worker>());
+	}
+	mThreads.reserve(threads);
+	for (std::size_t i{}; i < threads; ++i) {
+		mThreads.emplace_back([this, i](const std::stop_token stop) {
+			workerLoop(stop, i);
+		});
+	}
+}
+
+JobSystem::~JobSystem() {
+	for (auto& thread : mThreads) { thread.request_stop(); }
+	mThreads.clear();
+}
+
+JobSystem::Worker& JobSystem::callerWorker() noexcept {
+	return *mWorkers[sPool == this ? sSlot : mThreads.size()];
+}
+
+std::optional<JobSystem::Task> JobSystem::takeTask(Worker& self) noexcept {
+	{
+		std::scoped_lock lock{ self.lock };
+		if (!self.tasks.empty()) {
+			const auto task{ self.tasks.back() };
+			self.tasks.pop_back();
+			mQueued.fetch_sub(1, std::memory_order_relaxed);
+			return task;
+		}
+	}
+
+	const auto count{ mWorkers.size() };
+	const auto start{ static_cast<std::size_t>(&self - mWorkers.front().get()) };
+	for (std::size_t i{ 1 }; i < count; ++i) {
+		auto& victim{ *mWorkers[(start + i) % count] };
+		if (&victim == &self) { continue; }
+
+		std::scoped_lock lock{ victim.lock };
+		if (!victim.tasks.empty()) {
+			const auto task{ victim.tasks.front() };
+			victim.tasks.pop_front();
+			mQueued.fetch_sub(1, std::memory_order_relaxed);
+			self.stolen.fetch_add(1, std::memory_order_relaxed);
+			return task;
+		}
+	}
+	return std::nullopt;
+}
+
+void JobSystem::runTask(const Task& task, Worker& self) noexcept {
+	const auto timeStart{ std::chrono::steady_clock::now() };
+	task.func(task.body, task.begin, task.end);
+	const auto nanos{ static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - timeStart).count()) };
+
+	self.ran.fetch_add(1, std::memory_order_relaxed);
+	self.nanos.fetch_add(nanos, std::memory_order_relaxed);
+
+	if (task.timer) {
+		task.timer->tasks.fetch_add(1, std::memory_order_relaxed);
+		task.timer->nanos.fetch_add(nanos, std::memory_order_relaxed);
+		auto longest{ task.timer->longest.load(std::memory_order_relaxed) };
+		while (longest < nanos && !task.timer->longest.compare_exchange_weak(
+			longest, nanos, std::memory_order_relaxed)) {}
+	}
+
+	// the caller may return the moment this reaches 0, so it goes last
+	if (task.pending) { task.pending->fetch_sub(1, std::memory_order_release); }
+}
+
+void JobSystem::workerLoop(const std::stop_token stop, const std::size_t slot) {
+	sPool = this;
+	sSlot = slot;
+
+	auto& self{ *mWorkers[slot] };
+	while (!stop.stop_requested()) {
+		if (const auto task{ takeTask(self) }) {
+			runTask(*task, self);
+			continue;
+		}
+		std::unique_lock lock{ mSleepLock };
+		mWake.wait(lock, stop, [this]() noexcept {
+			return mQueued.load(std::memory_order_acquire) > 0;
+		});
+	}
+}
+
+void JobSystem::submit(
+	const TaskFunc func, void* const body,
+	const std::size_t begin, const std::size_t end, const std::size_t band,
+	std::atomic<std::size_t>& pending, Timer* const timer
+) {
+	auto& self{ callerWorker() };
+
+	// counted before queueing so that taking a band never finds it short
+	mQueued.fetch_add(pending.load(std::memory_order_relaxed), std::memory_order_release);
+	{
+		std::scoped_lock lock{ self.lock };
+		for (auto first{ begin }; first < end; first += band) {
+			self.tasks.push_back({ func, body, first, std::min(first + band, end), timer, &pending });
+		}
+	}
+
+	// taking the lock orders this against a worker between its check and its wait
+	{ std::scoped_lock lock{ mSleepLock }; }
+	mWake.notify_all();
+}
+
+void JobSystem::helpUntil(const std::atomic<std::size_t>& pending) noexcept {
+	auto& self{ callerWorker() };
+	while (pending.load(std::memory_order_acquire)) {
+		if (const auto task{ takeTask(self) }) {
+			runTask(*task, self);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+JobSystem::Stats JobSystem::getStats() const noexcept {
+	Stats stats{};
+	for (const auto& worker : mWorkers) {
+		stats.tasks  += worker->ran.load(std::memory_order_relaxed);
+		stats.stolen += worker->stolen.load(std::memory_order_relaxed);
+		stats.nanos  += worker->nanos.load(std::memory_order_relaxed);
+	}
+	return stats;
+}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
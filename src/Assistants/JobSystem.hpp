@@ -0,0 +1,138 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <stop_token>
+#include <type_traits>
+#include <condition_variable>
+
+/*==================================================================*/
+	#pragma region JobSystem Class
+/*==================================================================*/
+
+/*
+	Small work-stealing thread pool. parallel_for() splits a range into
+	bands of at most grain items, queues them on the deque of the thread
+	calling it, and helps run them until all are done; idle workers steal
+	bands from the front of any other deque. Calls may nest, a band is free
+	to start another parallel_for. Threads from outside the pool share one
+	deque of their own.
+*/
+
+class JobSystem final {
+public:
+	// Counts bands and the time spent in them, for whoever wants to know
+	struct Timer final {
+		std::atomic<std::uint64_t> tasks{};
+		std::atomic<std::uint64_t> nanos{};
+		std::atomic<std::uint64_t> longest{};
+	};
+
+	struct Stats final {
+		std::uint64_t tasks;  // bands run in total
+		std::uint64_t stolen; // of which taken from another thread's deque
+		std::uint64_t nanos;  // time spent running them
+	};
+
+private:
+	using TaskFunc = void(*)(void*, std::size_t, std::size_t);
+
+	struct Task final {
+		TaskFunc    func{};
+		void*       body{};
+		std::size_t begin{}, end{};
+		Timer*      timer{};
+		std::atomic<std::size_t>* pending{};
+	};
+
+	struct alignas(64) Worker final {
+		std::mutex       lock{};
+		std::deque<Task> tasks{};
+
+		std::atomic<std::uint64_t> ran{};
+		std::atomic<std::uint64_t> stolen{};
+		std::atomic<std::uint64_t> nanos{};
+	};
+
+	// one per pool thread, the last one shared by threads outside the pool
+	std::vector<std::unique_ptr<Worker>> mWorkers{};
+	std::vector<std::jthread> mThreads{};
+
+	std::atomic<std::size_t> mQueued{};
+	std::mutex mSleepLock{};
+	std::condition_variable_any mWake{};
+
+	Worker& callerWorker() noexcept;
+	std::optional<Task> takeTask(Worker&) noexcept;
+	void runTask(const Task&, Worker&) noexcept;
+	void workerLoop(std::stop_token, std::size_t);
+
+	void submit(TaskFunc, void*, std::size_t, std::size_t, std::size_t,
+		std::atomic<std::size_t>&, Timer*);
+	void helpUntil(const std::atomic<std::size_t>&) noexcept;
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+public:
+	// Pool with given worker threads, 0 running everything on the caller
+	explicit JobSystem(std::size_t threads);
+	~JobSystem();
+
+	// Shared pool, one thread less than the hardware has, the caller being the last
+	static JobSystem& create() {
+		static JobSystem _self{ std::max(std::thread::hardware_concurrency(), 1u) - 1u };
+		return _self;
+	}
+
+	[[nodiscard]] std::size_t threadCount() const noexcept { return mThreads.size(); }
+	[[nodiscard]] Stats getStats() const noexcept;
+
+	// Call func(first, last) over [begin, end) in bands of at most grain,
+	// on the pool and the calling thread, returning once all are done
+	template <typename F>
+	void parallel_for(
+		const std::size_t begin, const std::size_t end,
+		const std::size_t grain, F&& func, Timer* const timer = nullptr
+	) {
+		if (begin >= end) { return; }
+		const auto band{ std::max<std::size_t>(grain, 1) };
+
+		using Body = std::remove_reference_t<F>;
+		const TaskFunc trampoline{ [](void* body, const std::size_t first, const std::size_t last) {
+			(*static_cast<Body*>(body))(first, last);
+		} };
+		void* const body{ const_cast<void*>(static_cast<const void*>(std::addressof(func))) };
+
+		if (mThreads.empty() || end - begin <= band) {
+			runTask({ trampoline, body, begin, end, timer, nullptr }, callerWorker());
+			return;
+		}
+
+		std::atomic<std::size_t> pending{ (end - begin + band - 1) / band };
+		submit(trampoline, body, begin, end, band, pending, timer);
+		helpUntil(pending);
+	}
+};
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+namespace bjs { // basic job system
+	extern JobSystem& jobs;
+}
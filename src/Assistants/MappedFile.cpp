@@ -0,0 +1,81 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+#include "MappedFile.hpp"
+
+MappedFile::MappedFile(const std::filesystem::path& path) noexcept {
+#ifdef _WIN32
+	const auto file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+	if (file == INVALID_HANDLE_VALUE) { return; }
+	mFile = file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) { return; }
+	mSize = static_cast<std::size_t>(size.QuadPart);
+#else
+	mFile = open(path.c_str(), O_RDONLY);
+	if (mFile < 0) { return; }
+
+	struct stat info;
+	if (fstat(mFile, &info)) { return; }
+	mSize = static_cast<std::size_t>(info.st_size);
+#endif
+	map(false);
+}
+
+MappedFile::MappedFile(const std::filesystem::path& path, const std::size_t size) noexcept {
+#ifdef _WIN32
+	const auto file{ CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0,
+		nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+	if (file == INVALID_HANDLE_VALUE) { return; }
+	mFile = file;
+#else
+	mFile = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (mFile < 0) { return; }
+	if (ftruncate(mFile, static_cast<off_t>(size))) { return; }
+#endif
+	mSize = size;
+	map(true);
+}
+
+bool MappedFile::map(const bool writable) noexcept {
+	if (!mSize) { return false; }
+#ifdef _WIN32
+	mMapping = CreateFileMappingW(mFile, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+		static_cast<DWORD>(static_cast<std::uint64_t>(mSize) >> 32), static_cast<DWORD>(mSize), nullptr);
+	if (!mMapping) { return false; }
+
+	void* data{ MapViewOfFile(mMapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, mSize) };
+	if (!data) { return false; }
+#else
+	void* data{ mmap(nullptr, mSize, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+		writable ? MAP_SHARED : MAP_PRIVATE, mFile, 0) };
+	if (data == MAP_FAILED) { return false; }
+#endif
+	mData = static_cast<std::uint8_t*>(data);
+	return true;
+}
+
+MappedFile::~MappedFile() noexcept {
+#ifdef _WIN32
+	if (mData)    { UnmapViewOfFile(mData); }
+	if (mMapping) { CloseHandle(mMapping); }
+	if (mFile)    { CloseHandle(mFile); }
+#else
+	if (mData)      { munmap(mData, mSize); }
+	if (mFile >= 0) { close(mFile); }
+#endif
+}
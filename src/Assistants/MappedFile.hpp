@@ -0,0 +1,47 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/*
+	A file mapped into memory, so its contents can be copied in or out
+	directly without going through stream buffers. Writable mappings are
+	created at a fixed size, read-only mappings cover the whole file.
+*/
+
+class MappedFile final {
+	std::uint8_t* mData{};
+	std::size_t   mSize{};
+
+#ifdef _WIN32
+	void* mFile{};
+	void* mMapping{};
+#else
+	int   mFile{ -1 };
+#endif
+
+	bool map(bool writable) noexcept;
+
+public:
+	// Map an existing file read-only
+	explicit MappedFile(const std::filesystem::path& path) noexcept;
+	// Create or truncate a file to given size and map it read-write
+	explicit MappedFile(const std::filesystem::path& path, std::size_t size) noexcept;
+	~MappedFile() noexcept;
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	[[nodiscard]] bool valid() const noexcept { return mData; }
+
+	// Bytes of the mapping, only writable if the file was mapped read-write
+	std::span<std::uint8_t> data() const noexcept { return { mData, mSize }; }
+};
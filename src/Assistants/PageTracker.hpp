@@ -0,0 +1,66 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <span>
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/*
+	Remembers when each page of a block of memory was last written, as the
+	stamp current at the time. Taking a stamp with mark() starts a new one,
+	so pages written after it are exactly those stamped later. The block
+	size must be a power of two, pages are 4 KiB.
+*/
+
+class PageTracker final {
+	std::uint8_t* mMemory{};
+	std::size_t   mSize{};
+
+	std::vector<std::uint32_t> mStamps{};
+	std::uint32_t mStamp{ 1 };
+
+public:
+	static constexpr std::size_t cPageBits{ 12 };
+	static constexpr std::size_t cPageSize{ 1u << cPageBits };
+
+	// Start tracking given block, all of it counting as written before any stamp
+	void track(std::span<std::uint8_t> memory) {
+		mMemory = memory.data();
+		mSize   = memory.size();
+		mStamps.assign((mSize + cPageSize - 1) >> cPageBits, 0);
+	}
+
+	[[nodiscard]] auto* data() const noexcept { return mMemory; }
+	[[nodiscard]] auto  size() const noexcept { return mSize; }
+
+	// Note a write at given offset, which must be within the block
+	void touch(const std::size_t pos) noexcept {
+		mStamps[pos >> cPageBits] = mStamp;
+	}
+
+	// Stamp to compare later writes against, never 0
+	[[nodiscard]] std::uint32_t mark() noexcept { return mStamp++; }
+
+	// Call func(offset, size) on each run of pages written after given
+	// stamp, or on the whole block for stamp 0
+	template <typename F>
+	void forEachSince(const std::uint32_t stamp, F&& func) const {
+		if (!stamp) {
+			if (mSize) { func(std::size_t{}, mSize); }
+			return;
+		}
+		for (std::size_t page{}; page < mStamps.size();) {
+			if (mStamps[page] <= stamp) { ++page; continue; }
+			const auto first{ page };
+			while (++page < mStamps.size() && mStamps[page] > stamp);
+			func(first << cPageBits, std::min(page << cPageBits, mSize) - (first << cPageBits));
+		}
+	}
+};
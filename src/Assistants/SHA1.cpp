@@ -8,7 +8,9 @@
 */
 
 #include "SHA1.hpp"
+#include "JobSystem.hpp"
 
+#include <bit>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
@@ -252,3 +254,14 @@ std::string SHA1::from_file(const std::string& filename) {
 	checksum.update(stream);
 	return checksum.final();
 }
+
+std::vector<std::string> SHA1::from_files(const std::vector<std::string>& filenames) {
+	std::vector<std::string> hashes(filenames.size());
+	bjs::jobs.parallel_for(0, filenames.size(), 1,
+		[&](const std::size_t first, const std::size_t last) {
+			for (auto i{ first }; i < last; ++i)
+				{ hashes[i] = from_file(filenames[i]); }
+		}
+	);
+	return hashes;
+}
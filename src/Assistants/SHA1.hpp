@@ -10,6 +10,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <cstdint>
 
 class SHA1 {
@@ -23,4 +24,6 @@ public:
 	void update(std::istream& is);
 	std::string final();
 	static std::string from_file(const std::string& filename);
+	// Hash of each file, several files at once on the shared job pool
+	static std::vector<std::string> from_files(const std::vector<std::string>& filenames);
 };
@@ -0,0 +1,85 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <span>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+/*
+	Fixed size queue between exactly one producer thread and one consumer
+	thread, without locking. N must be a power of two, one slot is always
+	left free to tell a full queue from an empty one.
+*/
+
+template <typename T, std::size_t N>
+class SPSCQueue final {
+	static_assert(N >= 2 && !(N & (N - 1)), "SPSCQueue size must be a power of two");
+	static constexpr std::size_t cMask{ N - 1 };
+
+	std::array<T, N> mSlots{};
+
+	alignas(64) std::atomic<std::size_t> mHead{}; // next slot to pop
+	alignas(64) std::atomic<std::size_t> mTail{}; // next slot to push
+
+public:
+	// Producer side, false if the queue is full and value was not taken
+	bool push(T value) noexcept {
+		const auto tail{ mTail.load(std::memory_order_relaxed) };
+		const auto next{ (tail + 1) & cMask };
+		if (next == mHead.load(std::memory_order_acquire)) { return false; }
+
+		mSlots[tail] = std::move(value);
+		mTail.store(next, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer side, false if the queue is empty and value was left as is
+	bool pop(T& value) noexcept {
+		const auto head{ mHead.load(std::memory_order_relaxed) };
+		if (head == mTail.load(std::memory_order_acquire)) { return false; }
+
+		value = std::move(mSlots[head]);
+		mHead.store((head + 1) & cMask, std::memory_order_release);
+		return true;
+	}
+
+	// Producer side, push as many of given values as fit, returns how many did
+	std::size_t pushRange(const std::span<const T> values) noexcept {
+		const auto tail{ mTail.load(std::memory_order_relaxed) };
+		const auto room{ (mHead.load(std::memory_order_acquire) - tail - 1) & cMask };
+		const auto count{ std::min(room, values.size()) };
+		const auto split{ std::min(count, N - tail) };
+
+		std::copy_n(values.begin(), split, mSlots.begin() + tail);
+		std::copy_n(values.begin() + split, count - split, mSlots.begin());
+		mTail.store((tail + count) & cMask, std::memory_order_release);
+		return count;
+	}
+
+	// Consumer side, pop as many values as queued to fill given span, returns how many
+	std::size_t popRange(const std::span<T> values) noexcept {
+		const auto head{ mHead.load(std::memory_order_relaxed) };
+		const auto held{ (mTail.load(std::memory_order_acquire) - head) & cMask };
+		const auto count{ std::min(held, values.size()) };
+		const auto split{ std::min(count, N - head) };
+
+		std::copy_n(mSlots.begin() + head, split, values.begin());
+		std::copy_n(mSlots.begin(), count - split, values.begin() + split);
+		mHead.store((head + count) & cMask, std::memory_order_release);
+		return count;
+	}
+
+	// Number of values queued, exact only from either side's own thread
+	[[nodiscard]] std::size_t size() const noexcept {
+		return (mTail.load(std::memory_order_acquire)
+			- mHead.load(std::memory_order_acquire)) & cMask;
+	}
+};
@@ -0,0 +1,80 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <pthread.h>
+	#include <sched.h>
+	#include <cstring>
+#endif
+
+#include <string>
+
+#include "BasicLogger.hpp"
+#include "ThreadTuning.hpp"
+
+using namespace blogger;
+
+bool ThreadTuning::applyToThisThread(const std::string_view name) const {
+	if (isDefault()) { return true; }
+
+	const std::string thread{ name };
+	bool applied{ true };
+
+	if (core >= 0) {
+	#if defined(_WIN32)
+		if (core >= 64 || !SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << core)) {
+			blog.stdLogOut("Could not pin " + thread + " thread to core " + std::to_string(core));
+			applied = false;
+		}
+	#elif defined(__linux__)
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(core, &cpus);
+		if (const auto error{ pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) }) {
+			blog.stdLogOut("Could not pin " + thread + " thread to core "
+				+ std::to_string(core) + ": " + std::strerror(error));
+			applied = false;
+		}
+	#else
+		blog.stdLogOut("Pinning threads to cores is not supported here, "
+			+ thread + " thread left free to move");
+		applied = false;
+	#endif
+	}
+
+	if (policy != Policy::NORMAL) {
+	#ifdef _WIN32
+		// the closest Windows has to a real-time policy for a single thread
+		if (!SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+			blog.stdLogOut("Could not raise priority of " + thread + " thread");
+			applied = false;
+		}
+	#else
+		const auto sched{ policy == Policy::FIFO ? SCHED_FIFO : SCHED_RR };
+		const auto lowest{ sched_get_priority_min(sched) };
+		const auto highest{ sched_get_priority_max(sched) };
+
+		// halfway up, leaving room above for the system's own real-time threads
+		sched_param param{};
+		param.sched_priority = lowest + (highest - lowest) / 2;
+
+		if (const auto error{ pthread_setschedparam(pthread_self(), sched, &param) }) {
+			blog.stdLogOut("Real-time scheduling refused for " + thread
+				+ " thread, staying on the default policy: " + std::strerror(error));
+			applied = false;
+		}
+	#endif
+	}
+
+	if (applied) {
+		blog.stdLogOut("Tuned " + thread + " thread"
+			+ (core >= 0 ? ", pinned to core " + std::to_string(core) : "")
+			+ (policy == Policy::FIFO ? ", SCHED_FIFO" : policy == Policy::RR ? ", SCHED_RR" : ""));
+	}
+	return applied;
+}
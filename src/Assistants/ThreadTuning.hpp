@@ -0,0 +1,29 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <string_view>
+
+/*
+	Where a thread should run and how it should be scheduled. Both are only
+	requests: when the platform or the permissions of the process do not
+	allow one, the thread carries on as it was and the reason is logged.
+*/
+
+struct ThreadTuning final {
+	enum class Policy { NORMAL, FIFO, RR };
+
+	int    core{ -1 }; // CPU core to pin to, -1 leaves the thread free to move
+	Policy policy{ Policy::NORMAL };
+
+	[[nodiscard]] bool isDefault() const noexcept {
+		return core < 0 && policy == Policy::NORMAL;
+	}
+
+	// Apply to the calling thread, false if any part of it was refused
+	bool applyToThisThread(std::string_view name) const;
+};
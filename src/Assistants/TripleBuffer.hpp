@@ -0,0 +1,48 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/*
+	Hands the latest of a stream of values from one producer thread to one
+	consumer thread without locking. The producer fills back() and calls
+	publish(), the consumer calls update() and reads front(); neither ever
+	waits on the other, and values published in between are skipped.
+*/
+
+template <typename T>
+class TripleBuffer final {
+	static constexpr std::uint8_t cIndex{ 0b011 };
+	static constexpr std::uint8_t cFresh{ 0b100 }; // middle slot not yet seen
+
+	std::array<T, 3> mSlots{};
+
+	alignas(64) std::atomic<std::uint8_t> mMiddle{ 1 };
+	alignas(64) std::uint8_t mBack{ 0 };  // producer side only
+	alignas(64) std::uint8_t mFront{ 2 }; // consumer side only
+
+public:
+	// Slot the producer fills next, its contents are whatever was swapped in
+	[[nodiscard]] T& back() noexcept { return mSlots[mBack]; }
+
+	// Make back() the newest value and take another slot to fill
+	void publish() noexcept {
+		mBack = mMiddle.exchange(mBack | cFresh, std::memory_order_acq_rel) & cIndex;
+	}
+
+	// Move the newest published value to front(), false if nothing new
+	bool update() noexcept {
+		if (!(mMiddle.load(std::memory_order_relaxed) & cFresh)) { return false; }
+		mFront = mMiddle.exchange(mFront, std::memory_order_acq_rel) & cIndex;
+		return true;
+	}
+
+	[[nodiscard]] const T& front() const noexcept { return mSlots[mFront]; }
+};
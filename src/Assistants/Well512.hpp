@@ -26,6 +26,12 @@ public:
 		}
 	}
 
+	explicit Well512(const std::uint64_t seed) {
+		for (auto i{ 0 }; i < 16; ++i) {
+			mState[i] = static_cast<result_type>(seed >> i);
+		}
+	}
+
 	result_type get() {
 		result_type a, b, c, d;
 
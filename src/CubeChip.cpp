@@ -7,12 +7,15 @@
 #include <SDL3/SDL_main.h>
 #include <SDL3/SDL.h>
 #include <optional>
+#include <cstdlib>
+#include <string_view>
 
 #include "HostClass/HomeDirManager.hpp"
 #include "HostClass/BasicVideoSpec.hpp"
 #include "HostClass/BasicAudioSpec.hpp"
 
 #include "HostClass/Host.hpp"
+#include "Assistants/ThreadTuning.hpp"
 
 int main(int argc, char* argv[]) {
 
@@ -45,6 +48,39 @@ int main(int argc, char* argv[]) {
 	SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0"); // until the UI is independent
 	SDL_SetHint(SDL_HINT_APP_NAME, "CubeChip");
 
+	/*
+		--pin-guest N / --pin-audio N pin those threads to core N, and
+		--realtime fifo|rr asks for a real-time policy for both of them.
+		--present-on-change starts with frames presented only on change.
+		The first argument that isn't an option is the rom to open.
+	*/
+	const char* romFile{};
+	ThreadTuning guestTuning{};
+	ThreadTuning audioTuning{};
+	bool presentOnChange{};
+
+	for (auto i{ 1 }; i < argc; ++i) {
+		const std::string_view arg{ argv[i] };
+		const bool hasValue{ i + 1 < argc };
+
+		if (arg == "--pin-guest" && hasValue) {
+			guestTuning.core = std::atoi(argv[++i]);
+		} else if (arg == "--pin-audio" && hasValue) {
+			audioTuning.core = std::atoi(argv[++i]);
+		} else if (arg == "--realtime" && hasValue) {
+			const std::string_view policy{ argv[++i] };
+			const auto realtime{
+				policy == "rr" ? ThreadTuning::Policy::RR : ThreadTuning::Policy::FIFO
+			};
+			guestTuning.policy = realtime;
+			audioTuning.policy = realtime;
+		} else if (arg == "--present-on-change") {
+			presentOnChange = true;
+		} else if (!romFile) {
+			romFile = argv[i];
+		}
+	}
+
 	std::optional<HomeDirManager> HDM;
 	std::optional<BasicVideoSpec> BVS;
 	std::optional<BasicAudioSpec> BAS;
@@ -55,10 +91,11 @@ int main(int argc, char* argv[]) {
 		BAS.emplace();
 	} catch (...) { return EXIT_FAILURE; }
 
-	VM_Host Host(
-		argc <= 1 ? nullptr : argv[1],
-		*HDM, *BVS, *BAS
-	);
+	BAS->tuneAudioThread(audioTuning);
+	BVS->isPresentOnChange(presentOnChange);
+
+	VM_Host Host(romFile, *HDM, *BVS, *BAS);
+	Host.tuneGuestThread(guestTuning);
 
 	return Host.runHost();
 }
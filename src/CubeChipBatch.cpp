@@ -0,0 +1,313 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <fstream>
+#include <memory>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include "Assistants/BasicLogger.hpp"
+#include "Assistants/JobSystem.hpp"
+#include "Assistants/SHA1.hpp"
+#include "HostClass/HomeDirManager.hpp"
+#include "HostClass/BasicVideoSpec.hpp"
+#include "HostClass/BasicAudioSpec.hpp"
+
+#include "GuestClass/EmuCores/EmuCores.hpp"
+#include "GuestClass/EmuCores/CHIP8_WIDE.hpp"
+#include "GuestClass/GameFileChecker.hpp"
+
+/*==================================================================*/
+	#pragma region Batch Runner
+/*==================================================================*/
+
+namespace fs = std::filesystem;
+
+struct BatchResult final {
+	bool accepted{};
+	u32  frames{};
+	u64  cycles{};
+	f64  millis{};
+	u64  hash{};
+};
+
+static bool matchWildcard(const char* pattern, const char* text) noexcept {
+	const char* starP{};
+	const char* starT{};
+	while (*text) {
+		if (*pattern == '?' || *pattern == *text) {
+			++pattern; ++text;
+		} else if (*pattern == '*') {
+			starP = pattern++;
+			starT = text;
+		} else if (starP) {
+			pattern = starP + 1;
+			text    = ++starT;
+		} else { return false; }
+	}
+	while (*pattern == '*') { ++pattern; }
+	return !*pattern;
+}
+
+static void collectRoms(const std::string& arg, std::vector<std::string>& roms) {
+	std::error_code error;
+
+	if (arg.starts_with('@')) {
+		std::ifstream list(arg.substr(1));
+		for (std::string line; std::getline(list, line);) {
+			if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+			if (!line.empty()) { collectRoms(line, roms); }
+		}
+		return;
+	}
+
+	const fs::path path{ arg };
+
+	if (arg.find_first_of("*?") != std::string::npos) {
+		const auto parent{ path.has_parent_path() ? path.parent_path() : fs::path{ "." } };
+		const auto filter{ path.filename().string() };
+		std::vector<std::string> found;
+
+		for (const auto& entry : fs::directory_iterator(parent, error)) {
+			if (!entry.is_regular_file(error)) { continue; }
+			if (matchWildcard(filter.c_str(), entry.path().filename().string().c_str())) {
+				found.push_back(entry.path().string());
+			}
+		}
+		std::sort(found.begin(), found.end());
+		roms.insert(roms.end(), found.begin(), found.end());
+		return;
+	}
+
+	if (fs::is_directory(path, error)) {
+		std::vector<std::string> found;
+
+		for (const auto& entry : fs::recursive_directory_iterator(path, error)) {
+			if (entry.is_regular_file(error)) {
+				found.push_back(entry.path().string());
+			}
+		}
+		std::sort(found.begin(), found.end());
+		roms.insert(roms.end(), found.begin(), found.end());
+		return;
+	}
+
+	roms.push_back(arg);
+}
+
+static u64 hashFramebuffer(const std::vector<u32>& pixels) noexcept {
+	u64 hash{ 0xCBF29CE484222325 }; // FNV-1a 64
+	for (const auto pixel : pixels) {
+		for (auto shift{ 0 }; shift < 32; shift += 8) {
+			hash ^= pixel >> shift & 0xFF;
+			hash *= 0x100000001B3;
+		}
+	}
+	return hash;
+}
+
+// Run LANES copies of a CHIP8_MODERN rom in lockstep, lane N seeded with seed + N
+template <usz LANES>
+static std::vector<BatchResult> runRomWide(
+	const HomeDirManager& HDM, const u32 frameLimit, const u64 seed
+) {
+	std::vector<u8> program(HDM.size);
+	std::ifstream file(HDM.path, std::ios::binary);
+	if (!file.read(reinterpret_cast<char*>(program.data()), program.size())) { return { {} }; }
+
+	const auto Guest{ std::make_unique<CHIP8_WIDE<LANES>>(program) };
+	for (usz lane{ 0 }; lane < LANES; ++lane) { Guest->seedLane(lane, seed + lane); }
+
+	const auto timeStart{ std::chrono::steady_clock::now() };
+	for (auto frame{ 0u }; frame < frameLimit && !Guest->isSystemStopped(); ++frame) {
+		Guest->processFrame();
+	}
+	const auto timeEnd{ std::chrono::steady_clock::now() };
+
+	std::vector<u32> pixels(64 * 32);
+	std::vector<BatchResult> results(LANES);
+	for (usz lane{ 0 }; lane < LANES; ++lane) {
+		Guest->copyDisplay(lane, pixels.data());
+
+		auto& result{ results[lane] };
+		result.accepted = true;
+		result.frames   = Guest->getTotalFrames(lane);
+		result.cycles   = Guest->getTotalCycles(lane);
+		result.millis   = std::chrono::duration<f64, std::milli>(timeEnd - timeStart).count();
+		result.hash     = hashFramebuffer(pixels);
+	}
+	return results;
+}
+
+static std::vector<BatchResult> runRom(
+	const std::string& rom, const std::string& sha1,
+	const u32 frameLimit, const u32 lanes, const u64 seed,
+	HomeDirManager& HDM, BasicVideoSpec& BVS, BasicAudioSpec& BAS
+) {
+	BatchResult result{};
+
+	GameFileChecker::delCore();
+	HDM.reset();
+
+	if (!HDM.verifyFile(GameFileChecker::validate, rom.c_str(), &sha1)) { return { result }; }
+	if (!GameFileChecker::hasCore()) { return { result }; }
+
+	if (lanes && GameFileChecker::getCore() == GameCoreType::CHIP8_MODERN) {
+		switch (lanes) {
+			case  8: return runRomWide< 8>(HDM, frameLimit, seed);
+			case 16: return runRomWide<16>(HDM, frameLimit, seed);
+			default: return runRomWide<32>(HDM, frameLimit, seed);
+		}
+	}
+
+	VM_Guest Guest;
+	if (!Guest.initGameCore(HDM, BVS, BAS)) { return { result }; }
+	result.accepted = true;
+
+	const auto timeStart{ std::chrono::steady_clock::now() };
+	while (Guest.getTotalFrames() < frameLimit && !Guest.isSystemStopped()) {
+		Guest.processFrame();
+	}
+	const auto timeEnd{ std::chrono::steady_clock::now() };
+
+	result.frames = Guest.getTotalFrames();
+	result.cycles = Guest.getTotalCycles();
+	result.millis = std::chrono::duration<f64, std::milli>(timeEnd - timeStart).count();
+	result.hash   = hashFramebuffer(BVS.headlessPixels());
+	return { result };
+}
+
+static void printUsage() {
+	std::printf(
+		"usage: CubeChipBatch [-f frames] [-j threads] [-w lanes] <rom|dir|glob|@list>...\n"
+		"  -f, --frames N   frames to run per ROM (default 600)\n"
+		"  -j, --jobs   N   worker threads (default: hardware threads)\n"
+		"  -w, --lanes  N   run CHIP-8 roms as 8/16/32 lockstep lanes, one RNG seed each\n"
+		"  -s, --seed   N   RNG seed of the first lane (default 1)\n"
+		"  -v, --verbose    echo log output to the console\n"
+	);
+}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+int main(int argc, char* argv[]) {
+	u32  frameLimit{ 600 };
+	u32  jobCount{ std::max(std::thread::hardware_concurrency(), 1u) };
+	u32  laneCount{};
+	u64  laneSeed{ 1 };
+	bool verbose{};
+
+	std::vector<std::string> roms;
+
+	for (auto i{ 1 }; i < argc; ++i) {
+		const std::string arg{ argv[i] };
+
+		if ((arg == "-f" || arg == "--frames") && i + 1 < argc) {
+			frameLimit = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+		} else if ((arg == "-j" || arg == "--jobs") && i + 1 < argc) {
+			jobCount = std::max(static_cast<u32>(std::strtoul(argv[++i], nullptr, 10)), 1u);
+		} else if ((arg == "-w" || arg == "--lanes") && i + 1 < argc) {
+			laneCount = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+			if (laneCount != 8 && laneCount != 16 && laneCount != 32) {
+				printUsage();
+				return EXIT_FAILURE;
+			}
+		} else if ((arg == "-s" || arg == "--seed") && i + 1 < argc) {
+			laneSeed = std::strtoull(argv[++i], nullptr, 10);
+		} else if (arg == "-v" || arg == "--verbose") {
+			verbose = true;
+		} else if (arg == "-h" || arg == "--help") {
+			printUsage();
+			return EXIT_SUCCESS;
+		} else {
+			collectRoms(arg, roms);
+		}
+	}
+
+	if (roms.empty()) {
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	blogger::blog.setConsoleEcho(verbose);
+
+	std::optional<HomeDirManager> HDM;
+	try {
+		HDM.emplace("CubeChip_SDL");
+	} catch (...) { return EXIT_FAILURE; }
+
+	std::vector<std::vector<BatchResult>> results(roms.size());
+
+	// the caller counts as one of the jobs, the pool runs the rest
+	jobCount = std::min(jobCount, static_cast<u32>(roms.size()));
+	JobSystem pool{ jobCount - 1u };
+
+	const auto hashStart{ std::chrono::steady_clock::now() };
+	const auto hashes{ SHA1::from_files(roms) };
+	const auto hashEnd{ std::chrono::steady_clock::now() };
+
+	JobSystem::Timer romTimer;
+
+	const auto timeStart{ std::chrono::steady_clock::now() };
+	pool.parallel_for(0, roms.size(), 1, [&](const usz first, const usz last) {
+		// each job owns its host stand-ins, the cores only ever see those
+		HomeDirManager localHDM{ *HDM };
+		BasicVideoSpec localBVS{ true };
+		BasicAudioSpec localBAS{ true };
+
+		for (auto index{ first }; index < last; ++index) {
+			results[index] = runRom(
+				roms[index], hashes[index], frameLimit, laneCount, laneSeed,
+				localHDM, localBVS, localBAS
+			);
+		}
+	}, &romTimer);
+	const auto timeEnd{ std::chrono::steady_clock::now() };
+
+	usz rejected{};
+	std::printf("rom,frames,cycles,ms,hash\n");
+	for (usz i{}; i < roms.size(); ++i) {
+		if (!results[i].front().accepted) {
+			std::printf("%s,rejected,,,\n", roms[i].c_str());
+			++rejected;
+			continue;
+		}
+		for (usz lane{}; lane < results[i].size(); ++lane) {
+			const auto& result{ results[i][lane] };
+			const auto name{ results[i].size() > 1
+				? roms[i] + "#" + std::to_string(lane) : roms[i] };
+
+			std::printf("%s,%u,%llu,%.3Lf,%016llx\n",
+				name.c_str(), result.frames,
+				static_cast<unsigned long long>(result.cycles), result.millis,
+				static_cast<unsigned long long>(result.hash)
+			);
+		}
+	}
+	const auto stats{ pool.getStats() };
+	std::fprintf(stderr, "%zu ROM(s), %zu rejected, %u thread(s), %.1Lf ms total\n",
+		roms.size(), rejected, jobCount,
+		std::chrono::duration<f64, std::milli>(timeEnd - timeStart).count()
+	);
+	std::fprintf(stderr, "hashed in %.1Lf ms, longest ROM %.1Lf ms, %llu of %llu stolen\n",
+		std::chrono::duration<f64, std::milli>(hashEnd - hashStart).count(),
+		romTimer.longest.load() / 1e6L,
+		static_cast<unsigned long long>(stats.stolen),
+		static_cast<unsigned long long>(stats.tasks)
+	);
+
+	return rejected ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,60 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+/*
+	Interpreter dispatch engine, chosen at build time.
+
+	GCC and Clang default to threaded dispatch: every handler jumps
+	straight to the next one through a label table (computed goto),
+	giving each opcode its own indirect branch to predict. Define
+	CUBECHIP_SWITCH_DISPATCH to build the reference switch engine
+	instead, which is also the only engine available on MSVC.
+*/
+
+#if !defined(CUBECHIP_SWITCH_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+	#define CUBECHIP_THREADED_DISPATCH
+#endif
+
+/*
+	CHIP8_MODERN can additionally recompile straight-line code into
+	x86-64 host code. The generated blocks follow the System V calling
+	convention, so the recompiler is only built on x86-64 Linux, and
+	can be left out by defining CUBECHIP_NO_JIT.
+*/
+
+#if !defined(CUBECHIP_NO_JIT) && defined(__x86_64__) && defined(__linux__)
+	#define CUBECHIP_JIT
+#endif
+
+/*
+	Cores with quirk-specialized loops pick the instantiation matching
+	their quirks. Define CUBECHIP_RUNTIME_QUIRKS to build them with the
+	runtime-tested variant only, for comparison.
+*/
+
+/*
+	CHIP8_WIDE steps its lanes with the widest vector unit the build
+	targets: AVX2 when enabled by the compiler (/arch:AVX2, -mavx2),
+	SSE2 on any other x86-64 build, and plain per-byte code elsewhere.
+*/
+
+#if defined(__AVX2__)
+	#define CUBECHIP_WIDE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || defined(__x86_64__)
+	#define CUBECHIP_WIDE_SSE2
+#endif
+
+/*
+	XOCHIP turns its bitplanes into texture colors with byte shuffles
+	(pshufb) when the build targets SSSE3 or later (/arch:AVX, -mssse3),
+	and with a table-driven bit spread on any other build.
+*/
+
+#if defined(__SSSE3__) || defined(__AVX__)
+	#define CUBECHIP_XO_SSSE3
+#endif
@@ -0,0 +1,268 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <utility>
+
+#include "CHIP8_LEGACY.hpp"
+
+#include "../../HostClass/HomeDirManager.hpp"
+#include "../../HostClass/BasicVideoSpec.hpp"
+#include "../../HostClass/BasicAudioSpec.hpp"
+
+
+
+CHIP8_LEGACY::~CHIP8_LEGACY() = default;
+CHIP8_LEGACY::CHIP8_LEGACY(
+	HomeDirManager& ref_HDM,
+	BasicVideoSpec& ref_BVS,
+	BasicAudioSpec& ref_BAS
+) noexcept
+	: EmuCores{ ref_HDM, ref_BVS, ref_BAS }
+{
+	copyGameToMemory(mMemoryBank.data(), cGameLoadPos);
+	copyFontToMemory(mMemoryBank.data(), 0, 80);
+
+	mProgCounter    = cStartOffset;
+	mFramerate      = cRefreshRate;
+	mCyclesPerFrame = cFrameCycles;
+
+	initPlatform();
+}
+
+void CHIP8_LEGACY::processFrame() {
+	if (isSystemStopped()) { return; }
+	else { ++mTotalFrames; }
+
+	Input.updateKeyStates();
+
+	const auto frameEnd{ mFrameCycle + std::abs(mCyclesPerFrame) };
+
+	scheduleFrameEvents();
+
+	while (!mEvents.empty()) {
+		const auto event{ mEvents.pop() };
+		instructionLoop(event.cycle);
+		handleEvent(event.type);
+	}
+	instructionLoop(frameEnd);
+	mFrameCycle = frameEnd;
+
+	renderAudioData();
+}
+
+void CHIP8_LEGACY::scheduleFrameEvents() noexcept {
+	mEvents.push(mFrameCycle,               Event::VBLANK);
+	mEvents.push(mFrameCycle + cIntrCycles, Event::DISPLAY);
+}
+
+void CHIP8_LEGACY::handleEvent(const Event type) {
+	switch (type) {
+		case Event::VBLANK:
+			handleVblankInterrupt();
+			return;
+
+		case Event::DISPLAY:
+			addCycles(cDmaCycles);
+			renderVideoData();
+			return;
+	}
+}
+
+void CHIP8_LEGACY::handleVblankInterrupt() noexcept {
+	if (mDelayTimer) { --mDelayTimer; }
+	if (mSoundTimer) { --mSoundTimer; }
+
+	switch (mInterruptType)
+	{
+		case Interrupt::FRAME:
+			mInterruptType  = Interrupt::CLEAR;
+			mCyclesPerFrame = std::abs(mCyclesPerFrame);
+			return;
+
+		case Interrupt::SOUND:
+			if (!mSoundTimer) {
+				mInterruptType  = Interrupt::FINAL;
+				mCyclesPerFrame = 0;
+			}
+			return;
+
+		case Interrupt::INPUT:
+			if (Input.keyPressed(mRegisterV[mInputReg], mTotalFrames)) {
+				mInterruptType  = Interrupt::CLEAR;
+				mCyclesPerFrame = std::abs(mCyclesPerFrame);
+				mSoundTimer     = 2;
+			}
+			return;
+
+		case Interrupt::ERROR:
+		case Interrupt::FINAL:
+			mCyclesPerFrame = 0;
+			return;
+	}
+}
+
+constexpr CHIP8_LEGACY::Opcode CHIP8_LEGACY::classifyOpcode(const u32 HI, const u32 LO) noexcept {
+	using enum Opcode;
+	switch (HI >> 4) {
+		case 0x0:
+			switch (HI << 8 | LO) {
+				case 0x00E0: return _00E0;
+				case 0x00EE: return _00EE;
+				default:     return ERROR_00NN;
+			}
+		case 0x1: return _1NNN;
+		case 0x2: return _2NNN;
+		case 0x3: return _3xNN;
+		case 0x4: return _4xNN;
+		case 0x5: return LO & 0xF ? ERROR_OPCODE : _5xy0;
+		case 0x6: return _6xNN;
+		case 0x7: return _7xNN;
+		case 0x8:
+			switch (LO & 0xF) {
+				case 0x0: return _8xy0;
+				case 0x1: return _8xy1;
+				case 0x2: return _8xy2;
+				case 0x3: return _8xy3;
+				case 0x4: return _8xy4;
+				case 0x5: return _8xy5;
+				case 0x7: return _8xy7;
+				case 0x6: return _8xy6;
+				case 0xE: return _8xyE;
+				default:  return ERROR_OPCODE;
+			}
+		case 0x9: return LO & 0xF ? ERROR_OPCODE : _9xy0;
+		case 0xA: return _ANNN;
+		case 0xB: return _BNNN;
+		case 0xC: return _CxNN;
+		case 0xD: return _DxyN;
+		case 0xE:
+			switch (LO) {
+				case 0x9E: return _Ex9E;
+				case 0xA1: return _ExA1;
+				default:   return ERROR_OPCODE;
+			}
+		default:
+			switch (LO) {
+				case 0x07: return _Fx07;
+				case 0x0A: return _Fx0A;
+				case 0x15: return _Fx15;
+				case 0x18: return _Fx18;
+				case 0x1E: return _Fx1E;
+				case 0x29: return _Fx29;
+				case 0x33: return _Fx33;
+				case 0x55: return _Fx55;
+				case 0x65: return _Fx65;
+				default:   return ERROR_OPCODE;
+			}
+	}
+}
+
+const std::array<CHIP8_LEGACY::Opcode, 0x10000>
+	CHIP8_LEGACY::cOpcodeTable{ makeOpcodeTable<Opcode>(classifyOpcode) };
+
+void CHIP8_LEGACY::instructionLoop(const u64 target) {
+
+	auto cycleCount{ 0 };
+	while (mCycleNow < target) {
+		// interpreter is parked in a wait loop until the next interrupt
+		if (mCyclesPerFrame <= 0) [[unlikely]] { mCycleNow = target; break; }
+
+		const auto HI{ readMemory(mProgCounter++) };
+		const auto LO{ readMemory(mProgCounter++) };
+
+		const auto opcode{ cOpcodeTable[HI << 8 | LO] };
+		addCycles(cFetchCycles + cOpcodeCycles[std::to_underlying(opcode)]);
+		++cycleCount;
+
+		using enum Opcode;
+		switch (opcode) {
+			case _00E0: instruction_00E0();                         break;
+			case _00EE: instruction_00EE();                         break;
+			case _1NNN: instruction_1NNN((HI << 8 | LO) & 0xFFF);   break;
+			case _2NNN: instruction_2NNN((HI << 8 | LO) & 0xFFF);   break;
+			case _3xNN: instruction_3xNN(HI & 0xF, LO);             break;
+			case _4xNN: instruction_4xNN(HI & 0xF, LO);             break;
+			case _5xy0: instruction_5xy0(HI & 0xF, LO >> 4);        break;
+			case _6xNN: instruction_6xNN(HI & 0xF, LO);             break;
+			case _7xNN: instruction_7xNN(HI & 0xF, LO);             break;
+			case _8xy0: instruction_8xy0(HI & 0xF, LO >> 4);        break;
+			case _8xy1: instruction_8xy1(HI & 0xF, LO >> 4);        break;
+			case _8xy2: instruction_8xy2(HI & 0xF, LO >> 4);        break;
+			case _8xy3: instruction_8xy3(HI & 0xF, LO >> 4);        break;
+			case _8xy4: instruction_8xy4(HI & 0xF, LO >> 4);        break;
+			case _8xy5: instruction_8xy5(HI & 0xF, LO >> 4);        break;
+			case _8xy7: instruction_8xy7(HI & 0xF, LO >> 4);        break;
+			case _8xy6: instruction_8xy6(HI & 0xF, LO >> 4);        break;
+			case _8xyE: instruction_8xyE(HI & 0xF, LO >> 4);        break;
+			case _9xy0: instruction_9xy0(HI & 0xF, LO >> 4);        break;
+			case _ANNN: instruction_ANNN((HI << 8 | LO) & 0xFFF);   break;
+			case _BNNN: instruction_BNNN((HI << 8 | LO) & 0xFFF);   break;
+			case _CxNN: instruction_CxNN(HI & 0xF, LO);             break;
+			case _DxyN: instruction_DxyN(HI & 0xF, LO >> 4, LO & 0xF); break;
+			case _Ex9E: instruction_Ex9E(HI & 0xF);                 break;
+			case _ExA1: instruction_ExA1(HI & 0xF);                 break;
+			case _Fx07: instruction_Fx07(HI & 0xF);                 break;
+			case _Fx0A: instruction_Fx0A(HI & 0xF);                 break;
+			case _Fx15: instruction_Fx15(HI & 0xF);                 break;
+			case _Fx18: instruction_Fx18(HI & 0xF);                 break;
+			case _Fx1E: instruction_Fx1E(HI & 0xF);                 break;
+			case _Fx29: instruction_Fx29(HI & 0xF);                 break;
+			case _Fx33: instruction_Fx33(HI & 0xF);                 break;
+			case _Fx55: instruction_Fx55(HI & 0xF);                 break;
+			case _Fx65: instruction_Fx65(HI & 0xF);                 break;
+			[[unlikely]]
+			case ERROR_00NN: instructionErrorML(HI, LO);            break;
+			[[unlikely]]
+			default:         instructionError(HI, LO);              break;
+		}
+	}
+	mTotalCycles += cycleCount;
+}
+
+void CHIP8_LEGACY::jumpProgramTo(const s32 next) noexcept {
+	if (mProgCounter - 2 == next) [[unlikely]] {
+		setInterrupt(Interrupt::SOUND);
+	} else { mProgCounter = static_cast<u16>(next); }
+}
+
+void CHIP8_LEGACY::renderAudioData() {
+	std::vector<s16> audioBuffer(static_cast<usz>(BAS.getFrequency() / cRefreshRate));
+
+	if (mSoundTimer) {
+		const auto amplitute{ BAS.getAmplitude() };
+		for (auto& sample_s16 : audioBuffer) {
+			sample_s16 = mWavePhase > 0.5f ? amplitute : -amplitute;
+			mWavePhase = std::fmod(mWavePhase + mAudioTone, 1.0f);
+		}
+		BVS.setFrameColor(cBitsColor[0], cBitsColor[1]);
+	} else {
+		mWavePhase = 0.0f;
+		BVS.setFrameColor(cBitsColor[0], cBitsColor[0]);
+	}
+	BAS.pushAudioData(audioBuffer.data(), audioBuffer.size());
+}
+
+void CHIP8_LEGACY::renderVideoData() {
+	std::transform(
+		std::execution::unseq,
+		mDisplayBuffer.begin(),
+		mDisplayBuffer.end(),
+		BVS.lockTexture(),
+		[](const auto pixel) noexcept {
+			return 0xFF000000 | cBitsColor[pixel];
+		}
+	);
+	BVS.unlockTexture();
+}
+
+void CHIP8_LEGACY::initPlatform() {
+	mAudioTone = cBuzzerTone / BAS.getFrequency();
+
+	setDisplayResolution(64, 32);
+	BVS.setBackColor(cBitsColor[0]);
+	BVS.createTexture(mDisplayW, mDisplayH);
+	BVS.setAspectRatio(512, 256, +2);
+}
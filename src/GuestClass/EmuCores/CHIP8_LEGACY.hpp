@@ -0,0 +1,479 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <array>
+
+#include "EmuCores.hpp"
+
+class CHIP8_LEGACY final : public EmuCores {
+	static constexpr u32 cTotalMemory{ 0x1000u };
+	static constexpr u32 cGameLoadPos{ 0x0200u };
+	static constexpr u32 cStartOffset{ 0x0200u };
+	static constexpr f32 cRefreshRate{ 60.000f };
+	static constexpr f32 cBuzzerTone{ 1400.0f };
+
+	// COSMAC VIP timing, in machine cycles of 8 clocks at 1.76064 MHz
+	static constexpr s32 cFrameCycles{  3668  }; // one 60 Hz frame
+	static constexpr s32 cIntrCycles{     29  }; // interrupt routine until display DMA
+	static constexpr s32 cDmaCycles{    1024  }; // 128 scanlines of 8 DMA bytes
+	static constexpr s32 cFetchCycles{    40  }; // interpreter fetch and decode
+
+public:
+	static constexpr bool testGameSize(const usz size) noexcept {
+		return size + cGameLoadPos <= cTotalMemory;
+	}
+
+public:
+	explicit CHIP8_LEGACY(
+		HomeDirManager&,
+		BasicVideoSpec&,
+		BasicAudioSpec&
+	) noexcept;
+	~CHIP8_LEGACY() noexcept;
+
+	void processFrame() override;
+
+private:
+	u8  mRegisterV[16]{};
+	u16 mStackBank[16]{};
+
+	f32  mWavePhase{};
+	f32  mAudioTone{};
+
+	u8  mDelayTimer{};
+	u8  mSoundTimer{};
+
+	u16 mProgCounter{};
+
+	u8  mInputReg{};
+	u8  mStackTop{};
+	u16 mRegisterI{};
+
+	u64 mCycleNow{};   // machine cycles elapsed
+	u64 mFrameCycle{}; // machine cycle the current frame began on
+
+	std::array<u8, cTotalMemory>
+		mMemoryBank{};
+
+	std::array<u8, 64 * 32>
+		mDisplayBuffer{};
+
+	// Write memory at saved index using given value
+	void writeMemoryI(const u32 value, const u32 pos) noexcept {
+		mMemoryBank[mRegisterI + pos & mMemoryBank.size() - 1] = static_cast<u8>(value);
+	}
+
+	// Read memory at given index
+	auto readMemory(const u32 pos) const noexcept {
+		return mMemoryBank[pos & mMemoryBank.size() - 1];
+	}
+	// Read memory at saved index
+	auto readMemoryI(const u32 pos) const noexcept {
+		return mMemoryBank[mRegisterI + pos & mMemoryBank.size() - 1];
+	}
+
+	enum class Opcode : u8 {
+		ERROR_00NN, ERROR_OPCODE,
+		_00E0, _00EE, _1NNN, _2NNN, _3xNN, _4xNN, _5xy0, _6xNN, _7xNN,
+		_8xy0, _8xy1, _8xy2, _8xy3, _8xy4, _8xy5, _8xy7, _8xy6, _8xyE,
+		_9xy0, _ANNN, _BNNN, _CxNN, _DxyN, _Ex9E, _ExA1,
+		_Fx07, _Fx0A, _Fx15, _Fx18, _Fx1E, _Fx29, _Fx33, _Fx55, _Fx65,
+	};
+
+	// Base cost of every handler in machine cycles, in Opcode order.
+	// Skips, sprite rows, BCD digits and register copies add their own.
+	static constexpr u16 cOpcodeCycles[]{
+		0, 0,
+		3102,   10,   12,   26,   10,   10,   14,    6,   10,
+		  44,   44,   44,   44,   44,   44,   44,   44,   44,
+		  14,   12,   22,   36,   26,   14,   14,
+		  10,   16,   10,   10,   16,   16,   80,   14,   14,
+	};
+
+	static constexpr Opcode classifyOpcode(const u32 HI, const u32 LO) noexcept;
+
+	// Handler of every opcode, malformed encodings map to the error handlers
+	static const std::array<Opcode, 0x10000> cOpcodeTable;
+
+	enum class Event : u8 {
+		VBLANK,  // 60 Hz interrupt, timers tick
+		DISPLAY, // display DMA, the frame is latched
+	};
+
+	// Timestamped events in cycle order, queued up a whole frame at a time
+	class EventQueue final {
+		struct Entry final {
+			u64   cycle{};
+			Event type{};
+		};
+
+		std::array<Entry, 8> mEntries{};
+		u32 mHead{}, mTail{};
+
+	public:
+		bool  empty() const noexcept { return mHead == mTail; }
+		Entry pop()         noexcept { return mEntries[mHead++]; }
+
+		void push(const u64 cycle, const Event type) noexcept {
+			if (empty()) { mHead = mTail = 0; }
+			auto pos{ mTail++ };
+			for (; pos > mHead && mEntries[pos - 1].cycle > cycle; --pos)
+				{ mEntries[pos] = mEntries[pos - 1]; }
+			mEntries[pos] = { cycle, type };
+		}
+	} mEvents;
+
+private:
+	void initPlatform() override;
+
+	void renderAudioData();
+	void renderVideoData();
+
+	void instructionLoop(const u64 target);
+
+	void scheduleFrameEvents() noexcept;
+	void handleEvent(const Event);
+	void handleVblankInterrupt() noexcept;
+
+	void jumpProgramTo(s32) noexcept;
+
+	// Charge extra machine cycles to the running instruction
+	void addCycles(const s32 cycles) noexcept { mCycleNow += cycles; }
+
+/*==================================================================*/
+	#pragma region 0 instruction branch
+/*==================================================================*/
+
+	// 00E0 - erase whole display
+	void instruction_00E0() {
+		std::fill(
+			std::execution::unseq,
+			mDisplayBuffer.begin(),
+			mDisplayBuffer.end(),
+			u8()
+		);
+	}
+	// 00EE - return from subroutine
+	void instruction_00EE() {
+		mProgCounter = mStackBank[--mStackTop & 0xF];
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 1 instruction branch
+/*==================================================================*/
+
+	// 1NNN - jump to NNN
+	void instruction_1NNN(const s32 NNN) {
+		jumpProgramTo(NNN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 2 instruction branch
+/*==================================================================*/
+
+	// 2NNN - call subroutine at NNN
+	void instruction_2NNN(const s32 NNN) {
+		mStackBank[mStackTop++ & 0xF] = mProgCounter;
+		jumpProgramTo(NNN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 3 instruction branch
+/*==================================================================*/
+
+	// 3XNN - skip next instruction if VX == NN
+	void instruction_3xNN(const s32 X, const s32 NN) {
+		if (mRegisterV[X] == NN) { mProgCounter += 2; addCycles(4); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 4 instruction branch
+/*==================================================================*/
+
+	// 4XNN - skip next instruction if VX != NN
+	void instruction_4xNN(const s32 X, const s32 NN) {
+		if (mRegisterV[X] != NN) { mProgCounter += 2; addCycles(4); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 5 instruction branch
+/*==================================================================*/
+
+	// 5XY0 - skip next instruction if VX == VY
+	void instruction_5xy0(const s32 X, const s32 Y) {
+		if (mRegisterV[X] == mRegisterV[Y]) { mProgCounter += 2; addCycles(4); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 6 instruction branch
+/*==================================================================*/
+
+	// 6XNN - set VX = NN
+	void instruction_6xNN(const s32 X, const s32 NN) {
+		mRegisterV[X] = static_cast<u8>(NN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 7 instruction branch
+/*==================================================================*/
+
+	// 7XNN - set VX = VX + NN
+	void instruction_7xNN(const s32 X, const s32 NN) {
+		mRegisterV[X] += static_cast<u8>(NN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 8 instruction branch
+/*==================================================================*/
+
+	// 8XY0 - set VX = VY
+	void instruction_8xy0(const s32 X, const s32 Y) {
+		mRegisterV[X] = mRegisterV[Y];
+	}
+	// 8XY1 - set VX = VX | VY, VF = 0
+	void instruction_8xy1(const s32 X, const s32 Y) {
+		mRegisterV[X] |= mRegisterV[Y];
+		mRegisterV[0xF] = 0;
+	}
+	// 8XY2 - set VX = VX & VY, VF = 0
+	void instruction_8xy2(const s32 X, const s32 Y) {
+		mRegisterV[X] &= mRegisterV[Y];
+		mRegisterV[0xF] = 0;
+	}
+	// 8XY3 - set VX = VX ^ VY, VF = 0
+	void instruction_8xy3(const s32 X, const s32 Y) {
+		mRegisterV[X] ^= mRegisterV[Y];
+		mRegisterV[0xF] = 0;
+	}
+	// 8XY4 - set VX = VX + VY, VF = carry
+	void instruction_8xy4(const s32 X, const s32 Y) {
+		const auto sum{ mRegisterV[X] + mRegisterV[Y] };
+		mRegisterV[X]   = static_cast<u8>(sum);
+		mRegisterV[0xF] = static_cast<u8>(sum >> 8);
+	}
+	// 8XY5 - set VX = VX - VY, VF = !borrow
+	void instruction_8xy5(const s32 X, const s32 Y) {
+		const bool nborrow{ mRegisterV[X] >= mRegisterV[Y] };
+		mRegisterV[X]   = mRegisterV[X] - mRegisterV[Y];
+		mRegisterV[0xF] = nborrow;
+	}
+	// 8XY7 - set VX = VY - VX, VF = !borrow
+	void instruction_8xy7(const s32 X, const s32 Y) {
+		const bool nborrow{ mRegisterV[Y] >= mRegisterV[X] };
+		mRegisterV[X]   = mRegisterV[Y] - mRegisterV[X];
+		mRegisterV[0xF] = nborrow;
+	}
+	// 8XY6 - set VX = VY >> 1, VF = carry
+	void instruction_8xy6(const s32 X, const s32 Y) {
+		const bool lsb{ (mRegisterV[Y] & 1) == 1 };
+		mRegisterV[X]   = mRegisterV[Y] >> 1;
+		mRegisterV[0xF] = lsb;
+	}
+	// 8XYE - set VX = VY << 1, VF = carry
+	void instruction_8xyE(const s32 X, const s32 Y) {
+		const bool msb{ (mRegisterV[Y] >> 7) == 1 };
+		mRegisterV[X]   = mRegisterV[Y] << 1;
+		mRegisterV[0xF] = msb;
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 9 instruction branch
+/*==================================================================*/
+
+	// 9XY0 - skip next instruction if VX != VY
+	void instruction_9xy0(const s32 X, const s32 Y) {
+		if (mRegisterV[X] != mRegisterV[Y]) { mProgCounter += 2; addCycles(4); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region A instruction branch
+/*==================================================================*/
+
+	// ANNN - set I = NNN
+	void instruction_ANNN(const s32 NNN) {
+		mRegisterI = static_cast<u16>(NNN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region B instruction branch
+/*==================================================================*/
+
+	// BNNN - jump to NNN + V0
+	void instruction_BNNN(const s32 NNN) {
+		jumpProgramTo(NNN + mRegisterV[0]);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region C instruction branch
+/*==================================================================*/
+
+	// CXNN - set VX = rnd(256) & NN
+	void instruction_CxNN(const s32 X, const s32 NN) {
+		mRegisterV[X] = static_cast<u8>(Wrand.get() & NN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region D instruction branch
+/*==================================================================*/
+
+	// DXYN - draw N sprite rows at VX and VY, then wait for vblank
+	void instruction_DxyN(const s32 X, const s32 Y, const s32 N) {
+		const auto pX{ mRegisterV[X] & 63 };
+		const auto pY{ mRegisterV[Y] & 31 };
+
+		mRegisterV[0xF] = 0;
+
+		for (auto H{ 0 }; H < N && pY + H < 32; ++H) {
+			const auto DATA{ readMemoryI(H) };
+			auto* row{ &mDisplayBuffer[(pY + H) * 64] };
+
+			for (auto B{ 0 }; B < 8 && pX + B < 64; ++B) {
+				if (DATA & 0x80 >> B) {
+					if (!(row[pX + B] ^= 1))
+						{ mRegisterV[0xF] = 1; }
+				}
+			}
+		}
+		// each row is shifted into place one bit at a time
+		addCycles(N * (34 + (pX & 7) * 4));
+		setInterrupt(Interrupt::FRAME);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region E instruction branch
+/*==================================================================*/
+
+	// EX9E - skip next instruction if key VX down (p1)
+	void instruction_Ex9E(const s32 X) {
+		if ( Input.keyHeld_P1(mRegisterV[X])) { mProgCounter += 2; addCycles(4); }
+	}
+	// EXA1 - skip next instruction if key VX up (p1)
+	void instruction_ExA1(const s32 X) {
+		if (!Input.keyHeld_P1(mRegisterV[X])) { mProgCounter += 2; addCycles(4); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region F instruction branch
+/*==================================================================*/
+
+	// FX07 - set VX = delay timer
+	void instruction_Fx07(const s32 X) {
+		mRegisterV[X] = mDelayTimer;
+	}
+	// FX0A - set VX = key, wait for keypress
+	void instruction_Fx0A(const s32 X) {
+		setInterrupt(Interrupt::INPUT);
+		mInputReg = static_cast<u8>(X);
+	}
+	// FX15 - set delay timer = VX
+	void instruction_Fx15(const s32 X) {
+		mDelayTimer = mRegisterV[X];
+	}
+	// FX18 - set sound timer = VX
+	void instruction_Fx18(const s32 X) {
+		mSoundTimer = mRegisterV[X];
+	}
+	// FX1E - set I = I + VX
+	void instruction_Fx1E(const s32 X) {
+		mRegisterI += mRegisterV[X];
+	}
+	// FX29 - point I to 5 byte hex sprite from value in VX
+	void instruction_Fx29(const s32 X) {
+		mRegisterI = (mRegisterV[X] & 0xF) * 5;
+	}
+	// FX33 - store BCD of VX to RAM at I, I+1, I+2
+	void instruction_Fx33(const s32 X) {
+		const auto hundreds{ mRegisterV[X] / 100     };
+		const auto tens    { mRegisterV[X] / 10 % 10 };
+		const auto ones    { mRegisterV[X]      % 10 };
+		writeMemoryI(hundreds, 0);
+		writeMemoryI(tens,     1);
+		writeMemoryI(ones,     2);
+		// digits are counted out by repeated subtraction
+		addCycles((hundreds + tens + ones) * 16);
+	}
+	// FX55 - store V0..VX to RAM at I..I+X
+	void instruction_Fx55(const s32 X) {
+		for (auto idx{ 0 }; idx <= X; ++idx)
+			{ writeMemoryI(mRegisterV[idx], idx); }
+		mRegisterI += static_cast<u16>(X + 1);
+		addCycles((X + 1) * 14);
+	}
+	// FX65 - load V0..VX from RAM at I..I+X
+	void instruction_Fx65(const s32 X) {
+		for (auto idx{ 0 }; idx <= X; ++idx)
+			{ mRegisterV[idx] = readMemoryI(idx); }
+		mRegisterI += static_cast<u16>(X + 1);
+		addCycles((X + 1) * 14);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+};
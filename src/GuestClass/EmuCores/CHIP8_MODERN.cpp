@@ -4,9 +4,13 @@
 	file, You can obtain one at http://mozilla.org/MPL/2.0/.
 */
 
+#include <bit>
+#include <array>
+#include <cstring>
 #include <utility>
 
 #include "CHIP8_MODERN.hpp"
+#include "../DispatchEngine.hpp"
 
 #include "../../HostClass/HomeDirManager.hpp"
 #include "../../HostClass/BasicVideoSpec.hpp"
@@ -27,9 +31,51 @@ CHIP8_MODERN::CHIP8_MODERN(
 
 	mProgCounter    = cStartOffset;
 	mFramerate      = cRefreshRate;
-	mCyclesPerFrame = Quirk.waitVblank ? cInstSpeedHi : 5000000;
+	mCyclesPerFrame = Quirk.waitVblank ? cInstSpeedHi : cInstSpeedMax;
+
+#ifdef CUBECHIP_JIT
+	mJitEnabled = mJitArena.valid();
+#endif
 
 	initPlatform();
+	selectInstructionLoop();
+}
+
+namespace {
+	// Spread the low bits of idx over the set bits of mask, lowest first
+	constexpr u32 depositBits(u32 idx, u32 mask) noexcept {
+		auto bits{ 0u };
+		for (; mask; mask &= mask - 1, idx >>= 1)
+			{ if (idx & 1) { bits |= mask & ~(mask - 1); } }
+		return bits;
+	}
+	// Gather the bits of value found at the set bits of mask, lowest first
+	constexpr u32 extractBits(const u32 value, u32 mask) noexcept {
+		auto idx{ 0u }, pos{ 0u };
+		for (; mask; mask &= mask - 1, ++pos)
+			{ if (value & mask & ~(mask - 1)) { idx |= 1u << pos; } }
+		return idx;
+	}
+}
+
+void CHIP8_MODERN::selectInstructionLoop() noexcept {
+#ifdef CUBECHIP_RUNTIME_QUIRKS
+	mInstructionLoop = &CHIP8_MODERN::processInstructions<QUIRK_RUNTIME>;
+#else
+	static constexpr auto cLoops{ []<u32... IDX>(std::integer_sequence<u32, IDX...>) {
+		return std::array{ &CHIP8_MODERN::processInstructions<depositBits(IDX, cSpecialized)>... };
+	}(std::make_integer_sequence<u32, 1u << std::popcount(cSpecialized)>{}) };
+
+	mInstructionLoop = cLoops[extractBits(Quirk.mask(), cSpecialized)];
+#endif
+}
+
+template <u32 QUIRKS>
+void CHIP8_MODERN::processInstructions() {
+#ifdef CUBECHIP_JIT
+	if (mJitEnabled) [[likely]] { instructionLoopJit<QUIRKS>(); return; }
+#endif
+	instructionLoop<QUIRKS>();
 }
 
 void CHIP8_MODERN::processFrame() {
@@ -43,7 +89,7 @@ void CHIP8_MODERN::processFrame() {
 
 	handlePreFrameInterrupt();
 
-	instructionLoop();
+	(this->*mInstructionLoop)();
 
 	handleEndFrameInterrupt();
 
@@ -52,6 +98,28 @@ void CHIP8_MODERN::processFrame() {
 	renderVideoData();
 }
 
+void CHIP8_MODERN::saveCoreState(u8* dest) const noexcept {
+	std::memcpy(dest, static_cast<const CHIP8_MODERN_State*>(this), sizeof(CHIP8_MODERN_State));
+}
+
+void CHIP8_MODERN::loadCoreState(const u8* src) {
+	// assigned as a whole, the core may keep members in the tail padding of its base
+	CHIP8_MODERN_State state;
+	std::memcpy(&state, src, sizeof(state));
+
+	// only opcodes over bytes that differ are dropped, restoring often keeps the caches warm
+	for (u32 pos{}; pos < cTotalMemory; ++pos) {
+		if (mMemoryBank[pos] != state.mMemoryBank[pos]) { invalidateCache(pos); }
+	}
+	for (auto Y{ 0 }; Y < 32; ++Y) {
+		if (mDisplayBuffer[Y] != state.mDisplayBuffer[Y]) { markRowDirty(Y); }
+	}
+	static_cast<CHIP8_MODERN_State&>(*this) = state;
+
+	// returning from running ahead leaves the frame ahead on screen
+	if (!mRunningAhead) { renderVideoData(); }
+}
+
 void CHIP8_MODERN::handlePreFrameInterrupt() noexcept {
 	switch (mInterruptType)
 	{
@@ -88,151 +156,298 @@ void CHIP8_MODERN::handleEndFrameInterrupt() noexcept {
 	}
 }
 
+constexpr CHIP8_MODERN::Opcode CHIP8_MODERN::classifyOpcode(const u32 HI, const u32 LO) noexcept {
+	using enum Opcode;
+	switch (HI >> 4) {
+		case 0x0:
+			switch (HI << 8 | LO) {
+				case 0x00E0: return _00E0;
+				case 0x00EE: return _00EE;
+				default:     return ERROR_00NN;
+			}
+		case 0x1: return _1NNN;
+		case 0x2: return _2NNN;
+		case 0x3: return _3xNN;
+		case 0x4: return _4xNN;
+		case 0x5: return LO & 0xF ? ERROR_OPCODE : _5xy0;
+		case 0x6: return _6xNN;
+		case 0x7: return _7xNN;
+		case 0x8:
+			switch (LO & 0xF) {
+				case 0x0: return _8xy0;
+				case 0x1: return _8xy1;
+				case 0x2: return _8xy2;
+				case 0x3: return _8xy3;
+				case 0x4: return _8xy4;
+				case 0x5: return _8xy5;
+				case 0x7: return _8xy7;
+				case 0x6: return _8xy6;
+				case 0xE: return _8xyE;
+				default:  return ERROR_OPCODE;
+			}
+		case 0x9: return LO & 0xF ? ERROR_OPCODE : _9xy0;
+		case 0xA: return _ANNN;
+		case 0xB: return _BNNN;
+		case 0xC: return _CxNN;
+		case 0xD: return _DxyN;
+		case 0xE:
+			switch (LO) {
+				case 0x9E: return _Ex9E;
+				case 0xA1: return _ExA1;
+				default:   return ERROR_OPCODE;
+			}
+		default:
+			switch (LO) {
+				case 0x07: return _Fx07;
+				case 0x0A: return _Fx0A;
+				case 0x15: return _Fx15;
+				case 0x18: return _Fx18;
+				case 0x1E: return _Fx1E;
+				case 0x29: return _Fx29;
+				case 0x33: return _Fx33;
+				case 0x55: return _Fx55;
+				case 0x65: return _Fx65;
+				default:   return ERROR_OPCODE;
+			}
+	}
+}
+
+const std::array<CHIP8_MODERN::Opcode, 0x10000>
+	CHIP8_MODERN::cOpcodeTable{ makeOpcodeTable<Opcode>(classifyOpcode) };
+
+void CHIP8_MODERN::decodeInstruction(DecodedOpcode& inst, const u32 pos) noexcept {
+	const auto HI{ readMemory(pos + 0) };
+	const auto LO{ readMemory(pos + 1) };
+
+	inst.type = cOpcodeTable[HI << 8 | LO];
+	inst.X    = HI & 0xF;
+	inst.Y    = LO >> 4;
+	inst.N    = LO & 0xF;
+	inst.HI   = HI;
+	inst.NN   = LO;
+	inst.NNN  = (HI << 8 | LO) & 0xFFF;
+}
+
+#ifdef CUBECHIP_THREADED_DISPATCH
+
+template <u32 QUIRKS>
+void CHIP8_MODERN::instructionLoop() {
+	// label order must match the Opcode enum
+	static void* const cDispatch[]{
+		&&UNDECODED,
+		&&ERROR_00NN, &&ERROR_OPCODE,
+		&&_00E0, &&_00EE, &&_1NNN, &&_2NNN, &&_3xNN, &&_4xNN, &&_5xy0, &&_6xNN, &&_7xNN,
+		&&_8xy0, &&_8xy1, &&_8xy2, &&_8xy3, &&_8xy4, &&_8xy5, &&_8xy7, &&_8xy6, &&_8xyE,
+		&&_9xy0, &&_ANNN, &&_BNNN, &&_CxNN, &&_DxyN, &&_Ex9E, &&_ExA1,
+		&&_Fx07, &&_Fx0A, &&_Fx15, &&_Fx18, &&_Fx1E, &&_Fx29, &&_Fx33, &&_Fx55, &&_Fx65,
+	};
+
+	auto cycleCount{ 0 };
+	DecodedOpcode* inst;
+
+	#define DISPATCH_NEXT()                                           \
+		if (cycleCount >= mCyclesPerFrame) [[unlikely]] { goto END; } \
+		inst = &mDecodeCache[mProgCounter & mDecodeCache.size() - 1]; \
+		mProgCounter += 2;                                            \
+		goto *cDispatch[static_cast<u8>(inst->type)]
+
+	#define DISPATCH_DONE() \
+		++cycleCount; DISPATCH_NEXT()
+
+	DISPATCH_NEXT();
+
+	UNDECODED:
+		decodeInstruction(*inst, mProgCounter - 2);
+		goto *cDispatch[static_cast<u8>(inst->type)];
+
+	ERROR_00NN:   instructionErrorML(inst->HI, inst->NN);      DISPATCH_DONE();
+	ERROR_OPCODE: instructionError(inst->HI, inst->NN);        DISPATCH_DONE();
+
+	_00E0: instruction_00E0<QUIRKS>();                           DISPATCH_DONE();
+	_00EE: instruction_00EE();                           DISPATCH_DONE();
+	_1NNN: instruction_1NNN(inst->NNN);                  DISPATCH_DONE();
+	_2NNN: instruction_2NNN(inst->NNN);                  DISPATCH_DONE();
+	_3xNN: instruction_3xNN(inst->X, inst->NN);          DISPATCH_DONE();
+	_4xNN: instruction_4xNN(inst->X, inst->NN);          DISPATCH_DONE();
+	_5xy0: instruction_5xy0(inst->X, inst->Y);           DISPATCH_DONE();
+	_6xNN: instruction_6xNN(inst->X, inst->NN);          DISPATCH_DONE();
+	_7xNN: instruction_7xNN(inst->X, inst->NN);          DISPATCH_DONE();
+	_8xy0: instruction_8xy0(inst->X, inst->Y);           DISPATCH_DONE();
+	_8xy1: instruction_8xy1(inst->X, inst->Y);           DISPATCH_DONE();
+	_8xy2: instruction_8xy2(inst->X, inst->Y);           DISPATCH_DONE();
+	_8xy3: instruction_8xy3(inst->X, inst->Y);           DISPATCH_DONE();
+	_8xy4: instruction_8xy4(inst->X, inst->Y);           DISPATCH_DONE();
+	_8xy5: instruction_8xy5(inst->X, inst->Y);           DISPATCH_DONE();
+	_8xy7: instruction_8xy7(inst->X, inst->Y);           DISPATCH_DONE();
+	_8xy6: instruction_8xy6<QUIRKS>(inst->X, inst->Y);           DISPATCH_DONE();
+	_8xyE: instruction_8xyE<QUIRKS>(inst->X, inst->Y);           DISPATCH_DONE();
+	_9xy0: instruction_9xy0(inst->X, inst->Y);           DISPATCH_DONE();
+	_ANNN: instruction_ANNN(inst->NNN);                  DISPATCH_DONE();
+	_BNNN: instruction_BNNN(inst->NNN);                  DISPATCH_DONE();
+	_CxNN: instruction_CxNN(inst->X, inst->NN);          DISPATCH_DONE();
+	_DxyN: instruction_DxyN<QUIRKS>(inst->X, inst->Y, inst->N);  DISPATCH_DONE();
+	_Ex9E: instruction_Ex9E(inst->X);                    DISPATCH_DONE();
+	_ExA1: instruction_ExA1(inst->X);                    DISPATCH_DONE();
+	_Fx07: instruction_Fx07(inst->X);                    DISPATCH_DONE();
+	_Fx0A: instruction_Fx0A(inst->X);                    DISPATCH_DONE();
+	_Fx15: instruction_Fx15(inst->X);                    DISPATCH_DONE();
+	_Fx18: instruction_Fx18(inst->X);                    DISPATCH_DONE();
+	_Fx1E: instruction_Fx1E(inst->X);                    DISPATCH_DONE();
+	_Fx29: instruction_Fx29(inst->X);                    DISPATCH_DONE();
+	_Fx33: instruction_Fx33(inst->X);                    DISPATCH_DONE();
+	_Fx55: instruction_Fx55<QUIRKS>(inst->X);                    DISPATCH_DONE();
+	_Fx65: instruction_Fx65<QUIRKS>(inst->X);                    DISPATCH_DONE();
+
+	#undef DISPATCH_DONE
+	#undef DISPATCH_NEXT
+
+	END:
+	mTotalCycles += accountIdleCycles(cycleCount);
+}
+
+#else
+
+template <u32 QUIRKS>
 void CHIP8_MODERN::instructionLoop() {
 
 	auto cycleCount{ 0 };
 	for (; cycleCount < mCyclesPerFrame; ++cycleCount) {
-		const auto HI{ readMemory(mProgCounter++) };
-		const auto LO{ readMemory(mProgCounter++) };
-
-		switch (HI >> 4) {
-			case 0x0:
-				switch (HI << 8 | LO) {
-					case 0x00E0:
-						instruction_00E0();
-						break;
-					case 0x00EE:
-						instruction_00EE();
-						break;
-					[[unlikely]]
-					default: instructionErrorML(HI, LO);
-				}
-				break;
-			case 0x1:
-				instruction_1NNN((HI << 8 | LO) & 0xFFF);
-				break;
-			case 0x2:
-				instruction_2NNN((HI << 8 | LO) & 0xFFF);
-				break;
-			case 0x3:
-				instruction_3xNN(HI & 0xF, LO);
-				break;
-			case 0x4:
-				instruction_4xNN(HI & 0xF, LO);
-				break;
-			case 0x5:
-				if (LO & 0xF) [[unlikely]] {
-					instructionError(HI, LO);
-				} else {
-					instruction_5xy0(HI & 0xF, LO >> 4);
-				}
-				break;
-			case 0x6:
-				instruction_6xNN(HI & 0xF, LO);
-				break;
-			case 0x7:
-				instruction_7xNN(HI & 0xF, LO);
-				break;
-			case 0x8:
-				switch (LO & 0xF) {
-					case 0x0:
-						instruction_8xy0(HI & 0xF, LO >> 4);
-						break;
-					case 0x1:
-						instruction_8xy1(HI & 0xF, LO >> 4);
-						break;
-					case 0x2:
-						instruction_8xy2(HI & 0xF, LO >> 4);
-						break;
-					case 0x3:
-						instruction_8xy3(HI & 0xF, LO >> 4);
-						break;
-					case 0x4:
-						instruction_8xy4(HI & 0xF, LO >> 4);
-						break;
-					case 0x5:
-						instruction_8xy5(HI & 0xF, LO >> 4);
-						break;
-					case 0x7:
-						instruction_8xy7(HI & 0xF, LO >> 4);
-						break;
-					case 0x6:
-						instruction_8xy6(HI & 0xF, LO >> 4);
-						break;
-					case 0xE:
-						instruction_8xyE(HI & 0xF, LO >> 4);
-						break;
-					[[unlikely]]
-					default: instructionError(HI, LO);
-				}
-				break;
-			case 0x9:
-				if (LO & 0xF) [[unlikely]] {
-					instructionError(HI, LO);
-				} else {
-					instruction_9xy0(HI & 0xF, LO >> 4);
-				}
-				break;
-			case 0xA:
-				instruction_ANNN((HI << 8 | LO) & 0xFFF);
-				break;
-			case 0xB:
-				instruction_BNNN((HI << 8 | LO) & 0xFFF);
-				break;
-			case 0xC:
-				instruction_CxNN(HI & 0xF, LO);
-				break;
-			case 0xD:
-				instruction_DxyN(HI & 0xF, LO >> 4, LO & 0xF);
-				break;
-			case 0xE:
-				switch (LO) {
-					case 0x9E:
-						instruction_Ex9E(HI & 0xF);
-						break;
-					case 0xA1:
-						instruction_ExA1(HI & 0xF);
-						break;
-					[[unlikely]]
-					default: instructionError(HI, LO);
-				}
-				break;
-			case 0xF:
-				switch (LO) {
-					case 0x07:
-						instruction_Fx07(HI & 0xF);
-						break;
-					case 0x0A:
-						instruction_Fx0A(HI & 0xF);
-						break;
-					case 0x15:
-						instruction_Fx15(HI & 0xF);
-						break;
-					case 0x18:
-						instruction_Fx18(HI & 0xF);
-						break;
-					case 0x1E:
-						instruction_Fx1E(HI & 0xF);
-						break;
-					case 0x29:
-						instruction_Fx29(HI & 0xF);
-						break;
-					case 0x33:
-						instruction_Fx33(HI & 0xF);
-						break;
-					case 0x55:
-						instruction_Fx55(HI & 0xF);
-						break;
-					case 0x65:
-						instruction_Fx65(HI & 0xF);
-						break;
-					[[unlikely]]
-					default: instructionError(HI, LO);
-				}
-				break;
+		auto& inst{ mDecodeCache[mProgCounter & mDecodeCache.size() - 1] };
+		if (inst.type == Opcode::UNDECODED) [[unlikely]]
+			{ decodeInstruction(inst, mProgCounter); }
+		mProgCounter += 2;
+
+		executeInstruction<QUIRKS>(inst);
+	}
+	mTotalCycles += accountIdleCycles(cycleCount);
+}
+
+#endif
+
+template <u32 QUIRKS>
+void CHIP8_MODERN::executeInstruction(const DecodedOpcode& inst) {
+	using enum Opcode;
+	switch (inst.type) {
+		case _00E0: instruction_00E0<QUIRKS>();                        break;
+		case _00EE: instruction_00EE();                        break;
+		case _1NNN: instruction_1NNN(inst.NNN);                break;
+		case _2NNN: instruction_2NNN(inst.NNN);                break;
+		case _3xNN: instruction_3xNN(inst.X, inst.NN);         break;
+		case _4xNN: instruction_4xNN(inst.X, inst.NN);         break;
+		case _5xy0: instruction_5xy0(inst.X, inst.Y);          break;
+		case _6xNN: instruction_6xNN(inst.X, inst.NN);         break;
+		case _7xNN: instruction_7xNN(inst.X, inst.NN);         break;
+		case _8xy0: instruction_8xy0(inst.X, inst.Y);          break;
+		case _8xy1: instruction_8xy1(inst.X, inst.Y);          break;
+		case _8xy2: instruction_8xy2(inst.X, inst.Y);          break;
+		case _8xy3: instruction_8xy3(inst.X, inst.Y);          break;
+		case _8xy4: instruction_8xy4(inst.X, inst.Y);          break;
+		case _8xy5: instruction_8xy5(inst.X, inst.Y);          break;
+		case _8xy7: instruction_8xy7(inst.X, inst.Y);          break;
+		case _8xy6: instruction_8xy6<QUIRKS>(inst.X, inst.Y);          break;
+		case _8xyE: instruction_8xyE<QUIRKS>(inst.X, inst.Y);          break;
+		case _9xy0: instruction_9xy0(inst.X, inst.Y);          break;
+		case _ANNN: instruction_ANNN(inst.NNN);                break;
+		case _BNNN: instruction_BNNN(inst.NNN);                break;
+		case _CxNN: instruction_CxNN(inst.X, inst.NN);         break;
+		case _DxyN: instruction_DxyN<QUIRKS>(inst.X, inst.Y, inst.N);  break;
+		case _Ex9E: instruction_Ex9E(inst.X);                  break;
+		case _ExA1: instruction_ExA1(inst.X);                  break;
+		case _Fx07: instruction_Fx07(inst.X);                  break;
+		case _Fx0A: instruction_Fx0A(inst.X);                  break;
+		case _Fx15: instruction_Fx15(inst.X);                  break;
+		case _Fx18: instruction_Fx18(inst.X);                  break;
+		case _Fx1E: instruction_Fx1E(inst.X);                  break;
+		case _Fx29: instruction_Fx29(inst.X);                  break;
+		case _Fx33: instruction_Fx33(inst.X);                  break;
+		case _Fx55: instruction_Fx55<QUIRKS>(inst.X);                  break;
+		case _Fx65: instruction_Fx65<QUIRKS>(inst.X);                  break;
+		[[unlikely]]
+		case ERROR_00NN: instructionErrorML(inst.HI, inst.NN); break;
+		[[unlikely]]
+		default:         instructionError(inst.HI, inst.NN);   break;
+	}
+}
+
+#ifdef CUBECHIP_JIT
+
+template <u32 QUIRKS>
+void CHIP8_MODERN::instructionLoopJit() {
+
+	auto cycleCount{ 0 };
+	while (cycleCount < mCyclesPerFrame) {
+		if (mProgCounter < cTotalMemory) [[likely]] {
+			auto& block{ mJitBlocks[mProgCounter] };
+			if (!block.size) [[unlikely]]
+				{ compileJitBlock(block, mProgCounter); }
+
+			/*
+				Blocks hold no opcodes that can raise an interrupt, so one is
+				only entered if it fits the remaining budget whole, and will
+				end the frame on the same cycle the interpreter would.
+			*/
+			if (block.code && cycleCount + block.size <= mCyclesPerFrame) {
+				mProgCounter = static_cast<u16>(block.code(mRegisterV, &mRegisterI, &mDelayTimer));
+				cycleCount  += block.size;
+				continue;
+			}
+		}
+
+		auto& inst{ mDecodeCache[mProgCounter & mDecodeCache.size() - 1] };
+		if (inst.type == Opcode::UNDECODED) [[unlikely]]
+			{ decodeInstruction(inst, mProgCounter); }
+		mProgCounter += 2;
+
+		executeInstruction<QUIRKS>(inst);
+		++cycleCount;
+	}
+	mTotalCycles += accountIdleCycles(cycleCount);
+}
+
+#endif
+
+bool CHIP8_MODERN::testIdleLoop(const s32 head) noexcept {
+	const auto tailCounter{ mProgCounter };
+	u8 tailRegisterV[16];
+	std::copy_n(mRegisterV, 16, tailRegisterV);
+
+	/*
+		Run one pass of the loop body on the live registers. Only opcodes
+		that read registers, the delay timer or the keys are allowed, and
+		those inputs stay fixed until the next frame. If the pass returns
+		to the jump with the registers unchanged, every later pass will do
+		the same, so the rest of the frame would be spent spinning.
+	*/
+	auto pure{ true };
+	mProgCounter = static_cast<u16>(head);
+	while (pure && mProgCounter < tailCounter - 2) {
+		auto& inst{ mDecodeCache[mProgCounter & mDecodeCache.size() - 1] };
+		if (inst.type == Opcode::UNDECODED) [[unlikely]]
+			{ decodeInstruction(inst, mProgCounter); }
+		mProgCounter += 2;
+
+		using enum Opcode;
+		switch (inst.type) {
+			case _3xNN: instruction_3xNN(inst.X, inst.NN); break;
+			case _4xNN: instruction_4xNN(inst.X, inst.NN); break;
+			case _5xy0: instruction_5xy0(inst.X, inst.Y);  break;
+			case _6xNN: instruction_6xNN(inst.X, inst.NN); break;
+			case _9xy0: instruction_9xy0(inst.X, inst.Y);  break;
+			case _Ex9E: instruction_Ex9E(inst.X);          break;
+			case _ExA1: instruction_ExA1(inst.X);          break;
+			case _Fx07: instruction_Fx07(inst.X);          break;
+			default:    pure = false;                      break;
 		}
 	}
-	mTotalCycles += cycleCount;
+
+	const auto idle{
+		pure && mProgCounter == tailCounter - 2 &&
+		std::equal(mRegisterV, mRegisterV + 16, tailRegisterV)
+	};
+
+	std::copy_n(tailRegisterV, 16, mRegisterV);
+	mProgCounter = tailCounter;
+	return idle;
 }
 
 void CHIP8_MODERN::jumpProgramTo(const s32 next) noexcept {
@@ -248,6 +463,11 @@ f32  CHIP8_MODERN::calcAudioTone() const {
 }
 
 void CHIP8_MODERN::renderAudioData() {
+	if (mRunningAhead) {
+		BVS.setFrameColor(cBitsColor[0], cBitsColor[mSoundTimer ? 1 : 0]);
+		return;
+	}
+
 	std::vector<s16> audioBuffer(static_cast<usz>(BAS.getFrequency() / cRefreshRate));
 
 	if (mSoundTimer) {
@@ -265,16 +485,16 @@ void CHIP8_MODERN::renderAudioData() {
 }
 
 void CHIP8_MODERN::renderVideoData() {
-	std::transform(
-		std::execution::unseq,
-		mDisplayBuffer.begin(),
-		mDisplayBuffer.end(),
-		BVS.lockTexture(),
-		[](const auto pixel) noexcept {
-			return 0xFF000000 | cBitsColor[pixel];
+	if (mDirtyFirst > mDirtyLast) { return; }
+
+	auto* pixels{ BVS.lockTextureRows(mDirtyFirst, mDirtyLast) };
+	for (auto Y{ mDirtyFirst }; Y <= mDirtyLast; ++Y) {
+		for (auto X{ 63 }; X >= 0; --X) {
+			*pixels++ = 0xFF000000 | cBitsColor[mDisplayBuffer[Y] >> X & 1];
 		}
-	);
+	}
 	BVS.unlockTexture();
+	clearDirty();
 }
 
 void CHIP8_MODERN::initPlatform() {
@@ -282,4 +502,5 @@ void CHIP8_MODERN::initPlatform() {
 	BVS.setBackColor(cBitsColor[0]);
 	BVS.createTexture(mDisplayW, mDisplayH);
 	BVS.setAspectRatio(512, 256, +2);
+	markAllDirty();
 }
@@ -7,16 +7,53 @@
 #pragma once
 
 #include <array>
+#include <bit>
+#include <bitset>
+#include <type_traits>
 
+#include "../../Assistants/JitArena.hpp"
+#include "../DispatchEngine.hpp"
 #include "EmuCores.hpp"
 
-class CHIP8_MODERN final : public EmuCores {
+// Machine state of CHIP8_MODERN, trivially copyable so a save state is
+// one copy of it. The core inherits it to keep the members at hand.
+struct CHIP8_MODERN_State {
+	u8  mRegisterV[16]{};
+	u16 mStackBank[16]{};
+
+	f32  mWavePhase{};
+	f32  mAudioTone{};
+
+	u8  mDelayTimer{};
+	u8  mSoundTimer{};
+
+	u16 mProgCounter{};
+
+	u8  mInputReg{};
+	u8  mStackTop{};
+	u16 mRegisterI{};
+
+	std::array<u8, 0x1000>
+		mMemoryBank{};
+
+	// One row per word, leftmost pixel in the top bit
+	std::array<u64, 32>
+		mDisplayBuffer{};
+};
+
+class CHIP8_MODERN final : public EmuCores, private CHIP8_MODERN_State {
+	template <usz LANES> friend class CHIP8_WIDE; // shares decoding and constants
 	static constexpr u32 cTotalMemory{ 0x1000u };
 	static constexpr u32 cGameLoadPos{ 0x0200u };
 	static constexpr u32 cStartOffset{ 0x0200u };
 	static constexpr f32 cRefreshRate{ 60.000f };
 	static constexpr s32 cInstSpeedHi{     30  };
 	static constexpr s32 cInstSpeedLo{     11  };
+	static constexpr s32 cInstSpeedMax{ 5000000 };
+	static constexpr s32 cIdleLoopLen{      8  };
+
+	static constexpr s32 cDisplayWb{ 63 };
+	static constexpr s32 cDisplayHb{ 31 };
 
 public:
 	static constexpr bool testGameSize(const usz size) noexcept {
@@ -34,42 +71,94 @@ public:
 	void processFrame() override;
 
 private:
-	u8  mRegisterV[16]{};
-	u16 mStackBank[16]{};
+	static_assert(sizeof(mMemoryBank) == cTotalMemory);
+	static_assert(std::is_trivially_copyable_v<CHIP8_MODERN_State>);
 
-	f32  mWavePhase{};
-	f32  mAudioTone{};
+	usz  coreStateSize() const noexcept override { return sizeof(CHIP8_MODERN_State); }
+	void saveCoreState(u8* dest) const noexcept override;
+	void loadCoreState(const u8* src) override;
 
-	u8  mDelayTimer{};
-	u8  mSoundTimer{};
+	enum class Opcode : u8 {
+		UNDECODED,
+		ERROR_00NN, ERROR_OPCODE,
+		_00E0, _00EE, _1NNN, _2NNN, _3xNN, _4xNN, _5xy0, _6xNN, _7xNN,
+		_8xy0, _8xy1, _8xy2, _8xy3, _8xy4, _8xy5, _8xy7, _8xy6, _8xyE,
+		_9xy0, _ANNN, _BNNN, _CxNN, _DxyN, _Ex9E, _ExA1,
+		_Fx07, _Fx0A, _Fx15, _Fx18, _Fx1E, _Fx29, _Fx33, _Fx55, _Fx65,
+	};
 
-	u16 mProgCounter{};
+	// Opcode at an address unpacked into its handler and operands
+	struct DecodedOpcode final {
+		Opcode type{};
+		u8  X{}, Y{}, N{};
+		u8  HI{}, NN{};
+		u16 NNN{};
+	};
 
-	u8  mInputReg{};
-	u8  mStackTop{};
-	u16 mRegisterI{};
+	// Decoded opcodes, one per address so odd jump targets are cached too
+	std::array<DecodedOpcode, cTotalMemory>
+		mDecodeCache{};
 
-	std::array<u8, cTotalMemory>
-		mMemoryBank{};
+	static constexpr Opcode classifyOpcode(const u32 HI, const u32 LO) noexcept;
 
-	std::array<u8, 2048>
-		mDisplayBuffer{};
+	// Handler of every opcode, malformed encodings map to the error handlers
+	static const std::array<Opcode, 0x10000> cOpcodeTable;
+
+	void decodeInstruction(DecodedOpcode&, const u32 pos) noexcept;
+
+#ifdef CUBECHIP_JIT
+	static constexpr s32 cJitBlockLen{ 64 };
+
+	// Compiled block entry, returns the address of the next opcode
+	using JitBlockFn = u32(*)(u8* regV, u16* regI, u8* delay);
+
+	struct JitBlock final {
+		JitBlockFn code{};
+		s32 size{}; // opcodes in block, 0 if not compiled yet, -1 if not compilable
+	};
+
+	JitArena mJitArena;
+	bool     mJitEnabled{};
+
+	// Compiled blocks by start address
+	std::array<JitBlock, cTotalMemory>
+		mJitBlocks{};
+
+	std::bitset<cTotalMemory> mJitCoverage{}; // bytes read by compiled blocks
+	std::bitset<cTotalMemory> mJitHazards{};  // bytes modified at runtime, never compiled
+
+	void compileJitBlock(JitBlock&, const u32 pos);
+	void flushJitBlocks(const u32 pos) noexcept;
+#endif
+
+	// Drop the cached opcodes overlapping the byte at given index
+	void invalidateCache(const u32 pos) noexcept {
+		mDecodeCache[pos     & mDecodeCache.size() - 1].type = Opcode::UNDECODED;
+		mDecodeCache[pos - 1 & mDecodeCache.size() - 1].type = Opcode::UNDECODED;
+	#ifdef CUBECHIP_JIT
+		if (mJitCoverage.test(pos & mDecodeCache.size() - 1)) [[unlikely]]
+			{ flushJitBlocks(pos & mDecodeCache.size() - 1); }
+	#endif
+	}
 
 	bool constexpr in_range(const usz pos) const noexcept { return pos < mMemoryBank.size(); }
 
 	// Write memory at given index using given value
 	void writeMemory(const u32 value, const u32 pos) noexcept {
 		mMemoryBank[pos & mMemoryBank.size() - 1] = static_cast<u8>(value);
+		invalidateCache(pos);
 		//if (in_range(pos)) { mMemoryBank[pos] = static_cast<u8>(value); }
 	}
 	// Write memory at saved index using given value
 	void writeMemoryI(const u32 value, const u32 pos) noexcept {
 		mMemoryBank[mRegisterI + pos & mMemoryBank.size() - 1] = static_cast<u8>(value);
+		invalidateCache(mRegisterI + pos);
 		//if (in_range(mRegisterI + pos)) { mMemoryBank[mRegisterI + pos] = static_cast<u8>(value); }
 	}
 	// Write memory at saved index using given value
 	void writeMemoryI(const u32 value) noexcept {
 		mMemoryBank[mRegisterI & mMemoryBank.size() - 1] = static_cast<u8>(value);
+		invalidateCache(mRegisterI);
 		//if (in_range(mRegisterI)) { mMemoryBank[mRegisterI] = static_cast<u8>(value); }
 	}
 
@@ -90,12 +179,25 @@ private:
 	}
 
 private:
-	void initPlatform();
+	void initPlatform() override;
 
 	void renderAudioData();
 	void renderVideoData();
 
-	void instructionLoop();
+	// Quirks the instruction loops are specialized on, one instantiation per combination
+	static constexpr u32 cSpecialized{ QUIRK_SHIFT_VX | QUIRK_IDX_REG_NOINC | QUIRK_WAIT_VBLANK | QUIRK_WRAP_SPRITE };
+
+	using InstructionLoop = void (CHIP8_MODERN::*)();
+	InstructionLoop mInstructionLoop{};
+
+	void selectInstructionLoop() noexcept;
+
+	template <u32 QUIRKS> void processInstructions();
+	template <u32 QUIRKS> void instructionLoop();
+	template <u32 QUIRKS> void executeInstruction(const DecodedOpcode&);
+#ifdef CUBECHIP_JIT
+	template <u32 QUIRKS> void instructionLoopJit();
+#endif
 
 	void handlePreFrameInterrupt() noexcept;
 	void handleEndFrameInterrupt() noexcept;
@@ -103,20 +205,24 @@ private:
 	f32  calcAudioTone() const;
 	void jumpProgramTo(s32) noexcept;
 
+	// Check if a backward jump to given head closes a loop that cannot exit this frame
+	bool isIdleLoop(const s32 head) noexcept {
+		const auto span{ mProgCounter - 2 - head };
+		return span > 0 && span < cIdleLoopLen * 2 && testIdleLoop(head);
+	}
+	bool testIdleLoop(const s32 head) noexcept;
+
 /*==================================================================*/
 	#pragma region 0 instruction branch
 /*==================================================================*/
 
 	// 00E0 - erase whole display
+	template <u32 QUIRKS>
 	void instruction_00E0() {
-		if (Quirk.waitVblank) [[unlikely]]
+		if (testQuirk<QUIRKS, QUIRK_WAIT_VBLANK>()) [[unlikely]]
 			{ setInterrupt(Interrupt::FRAME); }
-		std::fill(
-			std::execution::unseq,
-			mDisplayBuffer.begin(),
-			mDisplayBuffer.end(),
-			u8()
-		);
+		mDisplayBuffer.fill(0);
+		markAllDirty();
 	}
 	// 00EE - return from subroutine
 	void instruction_00EE() {
@@ -133,6 +239,8 @@ private:
 
 	// 1NNN - jump to NNN
 	void instruction_1NNN(const s32 NNN) {
+		if (isIdleLoop(NNN)) [[unlikely]]
+			{ skipIdleLoop(); }
 		jumpProgramTo(NNN);
 	}
 
@@ -258,15 +366,17 @@ private:
 		mRegisterV[0xF] = nborrow;
 	}
 	// 8XY6 - set VX = VY >> 1, VF = carry
+	template <u32 QUIRKS>
 	void instruction_8xy6(const s32 X, const s32 Y) {
-		if (!Quirk.shiftVX) { mRegisterV[X] = mRegisterV[Y]; }
+		if (!testQuirk<QUIRKS, QUIRK_SHIFT_VX>()) { mRegisterV[X] = mRegisterV[Y]; }
 		const bool lsb{ (mRegisterV[X] & 1) == 1 };
 		mRegisterV[X]   = mRegisterV[X] >> 1;
 		mRegisterV[0xF] = lsb;
 	}
 	// 8XYE - set VX = VY << 1, VF = carry
+	template <u32 QUIRKS>
 	void instruction_8xyE(const s32 X, const s32 Y) {
-		if (!Quirk.shiftVX) { mRegisterV[X] = mRegisterV[Y]; }
+		if (!testQuirk<QUIRKS, QUIRK_SHIFT_VX>()) { mRegisterV[X] = mRegisterV[Y]; }
 		const bool msb{ (mRegisterV[X] >> 7) == 1 };
 		mRegisterV[X]   = mRegisterV[X] << 1;
 		mRegisterV[0xF] = msb;
@@ -332,64 +442,48 @@ private:
 	#pragma region D instruction branch
 /*==================================================================*/
 
-	void drawByte(
-		s32 X, s32 Y,
-		const usz DATA
-	) {
-		switch (DATA) {
-			case 0b00000000:
-				return;
-			case 0b10000000:
-				if (Quirk.wrapSprite) { X &= mDisplayWb; }
-				if (X < mDisplayW) {
-					if (!(mDisplayBuffer[Y * mDisplayW + X] ^= 1))
-						{ mRegisterV[0xF] = 1; }
-				}
-				return;
-			default:
-				if (Quirk.wrapSprite) { X &= mDisplayWb; }
-				else if (X >= mDisplayW) { return; }
-
-				for (auto B{ 0 }; B < 8; ++X &= mDisplayWb) {
-					if (DATA & 0x80 >> B++) {
-						if (!(mDisplayBuffer[Y * mDisplayW + X] ^= 1))
-							{ mRegisterV[0xF] = 1; }
-					}
-					if (!Quirk.wrapSprite && X == mDisplayWb) { return; }
-				}
-				return;
-		}
+	// Sprite row at the top bits placed at column X, the bits pushed past
+	// the right edge either wrapping around or clipped away
+	template <u32 QUIRKS>
+	u64 placeSprite(const u64 DATA, const s32 X) const noexcept {
+		if (testQuirk<QUIRKS, QUIRK_WRAP_SPRITE>())
+			{ return std::rotr(DATA, X); }
+		else
+			{ return DATA >> X; }
+	}
+
+	// XOR a placed sprite row into display row Y, raising VF on collision
+	void drawRow(const s32 Y, const u64 DATA) noexcept {
+		auto& row{ mDisplayBuffer[Y] };
+		mRegisterV[0xF] |= (row & DATA) != 0;
+		row ^= DATA;
+		markRowDirty(Y);
 	}
 
 	// DXYN - draw N sprite rows at VX and VY
+	template <u32 QUIRKS>
 	void instruction_DxyN(const s32 X, const s32 Y, const s32 N) {
-		if (Quirk.waitVblank) [[unlikely]]
+		if (testQuirk<QUIRKS, QUIRK_WAIT_VBLANK>()) [[unlikely]]
 			{ setInterrupt(Interrupt::FRAME); }
 
-		auto pX{ mRegisterV[X] & mDisplayWb };
-		auto pY{ mRegisterV[Y] & mDisplayHb };
+		const auto pX{ mRegisterV[X] & cDisplayWb };
+		auto       pY{ mRegisterV[Y] & cDisplayHb };
 
 		mRegisterV[0xF] = 0;
 
-		switch (N) {
-			case 1:
-				drawByte(pX, pY, readMemoryI());
-				break;
-			case 0:
-				for (auto H{ 0 }, I{ 0 }; H < 16; ++H, ++pY &= mDisplayHb)
-				{
-					drawByte(pX + 0, pY, readMemoryI(I++));
-					drawByte(pX + 8, pY, readMemoryI(I++));
-					if (!Quirk.wrapSprite && pY == mDisplayHb) { break; }
-				}
-				break;
-			default:
-				for (auto H{ 0 }; H < N; ++H, ++pY &= mDisplayHb)
-				{
-					drawByte(pX, pY, readMemoryI(H));
-					if (!Quirk.wrapSprite && pY == mDisplayHb) { break; }
-				}
-				break;
+		if (N == 0) {
+			for (auto H{ 0 }, I{ 0 }; H < 16; ++H, I += 2, ++pY &= cDisplayHb)
+			{
+				const auto DATA{ readMemoryI(I) << 8 | readMemoryI(I + 1) };
+				drawRow(pY, placeSprite<QUIRKS>(u64(DATA) << 48, pX));
+				if (!testQuirk<QUIRKS, QUIRK_WRAP_SPRITE>() && pY == cDisplayHb) { break; }
+			}
+		} else {
+			for (auto H{ 0 }; H < N; ++H, ++pY &= cDisplayHb)
+			{
+				drawRow(pY, placeSprite<QUIRKS>(u64(readMemoryI(H)) << 56, pX));
+				if (!testQuirk<QUIRKS, QUIRK_WRAP_SPRITE>() && pY == cDisplayHb) { break; }
+			}
 		}
 	}
 
@@ -451,17 +545,19 @@ private:
 		writeMemoryI(mRegisterV[X]      % 10, 2);
 	}
 	// FX55 - store V0..VX to RAM at I..I+X
+	template <u32 QUIRKS>
 	void instruction_Fx55(const s32 X) {
 		for (auto idx{ 0 }; idx <= X; ++idx)
 			{ writeMemoryI(mRegisterV[idx], idx); }
-		if (!Quirk.idxRegNoInc) [[likely]]
+		if (!testQuirk<QUIRKS, QUIRK_IDX_REG_NOINC>()) [[likely]]
 			{ mRegisterI += static_cast<u16>(X + 1); }
 	}
 	// FX65 - load V0..VX from RAM at I..I+X
+	template <u32 QUIRKS>
 	void instruction_Fx65(const s32 X) {
 		for (auto idx{ 0 }; idx <= X; ++idx)
 			{ mRegisterV[idx] = static_cast<u8>(readMemoryI(idx)); }
-		if (!Quirk.idxRegNoInc) [[likely]]
+		if (!testQuirk<QUIRKS, QUIRK_IDX_REG_NOINC>()) [[likely]]
 			{ mRegisterI += static_cast<u16>(X + 1); }
 	}
 
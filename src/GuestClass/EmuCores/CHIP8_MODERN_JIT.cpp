@@ -0,0 +1,229 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "CHIP8_MODERN.hpp"
+
+#ifdef CUBECHIP_JIT
+
+#include <vector>
+#include <initializer_list>
+
+/*
+	Blocks are compiled to plain functions of the form:
+		u32 block(u8* regV [rdi], u16* regI [rsi], u8* delay [rdx])
+	returning the address of the next opcode in eax. Only opcodes that
+	touch nothing but V, I and the delay timer are compiled, everything
+	else (memory, display, input, sound, calls) ends the block and is
+	left to the interpreter. A skip or jump opcode is compiled as the
+	last one of its block, selecting which address to return.
+*/
+
+namespace {
+	struct BlockEmitter final {
+		std::vector<u8> bytes;
+
+		void emit(const std::initializer_list<u8> list) {
+			bytes.insert(bytes.end(), list);
+		}
+		void emit32(const u32 value) {
+			emit({
+				static_cast<u8>(value >>  0), static_cast<u8>(value >>  8),
+				static_cast<u8>(value >> 16), static_cast<u8>(value >> 24),
+			});
+		}
+
+		void loadV(const s32 X)  { emit({ 0x0F, 0xB6, 0x47, static_cast<u8>(X) }); } // movzx eax, byte [rdi+X]
+		void loadVc(const s32 X) { emit({ 0x0F, 0xB6, 0x4F, static_cast<u8>(X) }); } // movzx ecx, byte [rdi+X]
+		void storeV(const s32 X) { emit({ 0x88, 0x47, static_cast<u8>(X) }); }       // mov [rdi+X], al
+		void storeVF()           { emit({ 0x88, 0x4F, 0x0F }); }                     // mov [rdi+15], cl
+
+		// mov eax, next; ret
+		void exitTo(const u32 next) {
+			emit({ 0xB8 }); emit32(next);
+			emit({ 0xC3 });
+		}
+		// mov eax, next; mov ecx, skip; cmovcc eax, ecx; ret
+		void exitSkip(const u32 next, const u8 cmovcc) {
+			emit({ 0xB8 }); emit32(next);
+			emit({ 0xB9 }); emit32(next + 2);
+			emit({ 0x0F, cmovcc, 0xC1 });
+			emit({ 0xC3 });
+		}
+	};
+
+	constexpr u8 CMOVE { 0x44 };
+	constexpr u8 CMOVNE{ 0x45 };
+}
+
+void CHIP8_MODERN::compileJitBlock(JitBlock& block, const u32 pos) {
+	BlockEmitter out;
+
+	auto size{ 0 };
+	auto addr{ pos };
+	auto ends{ false };
+
+	while (!ends && size < cJitBlockLen) {
+		if (addr + 1 >= cTotalMemory) { break; }
+		if (mJitHazards.test(addr) || mJitHazards.test(addr + 1)) { break; }
+
+		const auto HI{ readMemory(addr + 0) };
+		const auto LO{ readMemory(addr + 1) };
+
+		const auto X{ static_cast<u8>(HI & 0xF) };
+		const auto Y{ static_cast<u8>(LO >> 4) };
+		const auto N{ LO & 0xF };
+
+		switch (HI >> 4) {
+			case 0x1: {
+				// self-jumps raise an interrupt, and short backward
+				// jumps are left to the idle loop check
+				const auto span{ static_cast<s32>(addr) - ((HI << 8 | LO) & 0xFFF) };
+				if (span >= 0 && span < cIdleLoopLen * 2) { goto done; }
+				out.exitTo((HI << 8 | LO) & 0xFFF);
+				ends = true;
+			} break;
+			case 0x3: // cmp byte [rdi+X], NN
+				out.emit({ 0x80, 0x7F, X, LO });
+				out.exitSkip(addr + 2, CMOVE);
+				ends = true;
+				break;
+			case 0x4:
+				out.emit({ 0x80, 0x7F, X, LO });
+				out.exitSkip(addr + 2, CMOVNE);
+				ends = true;
+				break;
+			case 0x5:
+				if (N) { goto done; }
+				out.loadV(X); // cmp al, [rdi+Y]
+				out.emit({ 0x3A, 0x47, Y });
+				out.exitSkip(addr + 2, CMOVE);
+				ends = true;
+				break;
+			case 0x9:
+				if (N) { goto done; }
+				out.loadV(X);
+				out.emit({ 0x3A, 0x47, Y });
+				out.exitSkip(addr + 2, CMOVNE);
+				ends = true;
+				break;
+			case 0x6: // mov byte [rdi+X], NN
+				out.emit({ 0xC6, 0x47, X, LO });
+				break;
+			case 0x7: // add byte [rdi+X], NN
+				out.emit({ 0x80, 0x47, X, LO });
+				break;
+			case 0x8:
+				switch (N) {
+					case 0x0:
+						out.loadV(Y);
+						out.storeV(X);
+						break;
+					case 0x1: // or [rdi+X], al
+						out.loadV(Y);
+						out.emit({ 0x08, 0x47, X });
+						break;
+					case 0x2: // and [rdi+X], al
+						out.loadV(Y);
+						out.emit({ 0x20, 0x47, X });
+						break;
+					case 0x3: // xor [rdi+X], al
+						out.loadV(Y);
+						out.emit({ 0x30, 0x47, X });
+						break;
+					case 0x4: // add eax, ecx; mov [X], al; shr eax, 8; mov [F], al
+						out.loadV(X);
+						out.loadVc(Y);
+						out.emit({ 0x01, 0xC8 });
+						out.storeV(X);
+						out.emit({ 0xC1, 0xE8, 0x08 });
+						out.storeV(0xF);
+						break;
+					case 0x5: // sub al, cl; setae cl
+						out.loadV(X);
+						out.loadVc(Y);
+						out.emit({ 0x28, 0xC8, 0x0F, 0x93, 0xC1 });
+						out.storeV(X);
+						out.storeVF();
+						break;
+					case 0x7:
+						out.loadV(Y);
+						out.loadVc(X);
+						out.emit({ 0x28, 0xC8, 0x0F, 0x93, 0xC1 });
+						out.storeV(X);
+						out.storeVF();
+						break;
+					case 0x6: // shr al, 1; setc cl
+						out.loadV(Quirk.shiftVX ? X : Y);
+						out.emit({ 0xD0, 0xE8, 0x0F, 0x92, 0xC1 });
+						out.storeV(X);
+						out.storeVF();
+						break;
+					case 0xE: // shl al, 1; setc cl
+						out.loadV(Quirk.shiftVX ? X : Y);
+						out.emit({ 0xD0, 0xE0, 0x0F, 0x92, 0xC1 });
+						out.storeV(X);
+						out.storeVF();
+						break;
+					default: goto done;
+				}
+				break;
+			case 0xA: // mov word [rsi], NNN
+				out.emit({ 0x66, 0xC7, 0x06, LO, static_cast<u8>(HI & 0xF) });
+				break;
+			case 0xF:
+				switch (LO) {
+					case 0x07: // movzx eax, byte [rdx]
+						out.emit({ 0x0F, 0xB6, 0x02 });
+						out.storeV(X);
+						break;
+					case 0x15: // mov [rdx], al
+						out.loadV(X);
+						out.emit({ 0x88, 0x02 });
+						break;
+					case 0x1E: // add [rsi], ax
+						out.loadV(X);
+						out.emit({ 0x66, 0x01, 0x06 });
+						break;
+					case 0x29: // and eax, 15; lea eax, [rax+rax*4]; mov [rsi], ax
+						out.loadV(X);
+						out.emit({ 0x83, 0xE0, 0x0F, 0x8D, 0x04, 0x80, 0x66, 0x89, 0x06 });
+						break;
+					default: goto done;
+				}
+				break;
+			default: goto done;
+		}
+		++size;
+		addr += 2;
+	}
+done:
+	if (!size) { block.size = -1; return; }
+	if (!ends) { out.exitTo(addr); }
+
+	auto* entry{ mJitArena.commit(out.bytes) };
+	if (!entry) {
+		// arena is full, start over and try once more
+		flushJitBlocks(cTotalMemory);
+		entry = mJitArena.commit(out.bytes);
+		if (!entry) { block.size = -1; return; }
+	}
+
+	block.code = reinterpret_cast<JitBlockFn>(entry);
+	block.size = size;
+	for (auto idx{ pos }; idx < addr; ++idx)
+		{ mJitCoverage.set(idx); }
+}
+
+void CHIP8_MODERN::flushJitBlocks(const u32 pos) noexcept {
+	// a write landed in compiled code, keep it interpreted from now on
+	if (pos < cTotalMemory) { mJitHazards.set(pos); }
+
+	mJitBlocks.fill({});
+	mJitCoverage.reset();
+	mJitArena.reset();
+}
+
+#endif
@@ -0,0 +1,801 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <bit>
+#include <limits>
+#include <string>
+#include <cstdio>
+
+#if defined(CUBECHIP_WIDE_AVX2) || defined(CUBECHIP_WIDE_SSE2)
+	#include <immintrin.h>
+#endif
+
+#include "CHIP8_WIDE.hpp"
+#include "../../Assistants/BasicLogger.hpp"
+
+using namespace blogger;
+
+namespace {
+
+/*==================================================================*/
+	#pragma region LaneVec
+/*==================================================================*/
+
+	// One vector of lane bytes, masks are 0x00/0xFF per lane
+	struct LaneVec final {
+	#if defined(CUBECHIP_WIDE_AVX2)
+		__m256i v;
+
+		static LaneVec load(const u8* src) noexcept { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)) }; }
+		void store(u8* dst) const noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), v); }
+		static LaneVec splat(const u32 value) noexcept { return { _mm256_set1_epi8(static_cast<char>(value)) }; }
+
+		friend LaneVec operator+ (const LaneVec a, const LaneVec b) noexcept { return { _mm256_add_epi8(a.v, b.v) }; }
+		friend LaneVec operator- (const LaneVec a, const LaneVec b) noexcept { return { _mm256_sub_epi8(a.v, b.v) }; }
+		friend LaneVec operator& (const LaneVec a, const LaneVec b) noexcept { return { _mm256_and_si256(a.v, b.v) }; }
+		friend LaneVec operator| (const LaneVec a, const LaneVec b) noexcept { return { _mm256_or_si256(a.v, b.v) }; }
+		friend LaneVec operator^ (const LaneVec a, const LaneVec b) noexcept { return { _mm256_xor_si256(a.v, b.v) }; }
+		friend LaneVec operator==(const LaneVec a, const LaneVec b) noexcept { return { _mm256_cmpeq_epi8(a.v, b.v) }; }
+
+		static LaneVec adds(const LaneVec a, const LaneVec b) noexcept { return { _mm256_adds_epu8(a.v, b.v) }; }
+		static LaneVec max (const LaneVec a, const LaneVec b) noexcept { return { _mm256_max_epu8(a.v, b.v) }; }
+		static LaneVec shr1(const LaneVec a) noexcept {
+			return { _mm256_and_si256(_mm256_srli_epi16(a.v, 1), _mm256_set1_epi8(0x7F)) };
+		}
+		static LaneVec select(const LaneVec m, const LaneVec a, const LaneVec b) noexcept {
+			return { _mm256_blendv_epi8(b.v, a.v, m.v) };
+		}
+		u32 bits() const noexcept { return static_cast<u32>(_mm256_movemask_epi8(v)); }
+	#elif defined(CUBECHIP_WIDE_SSE2)
+		__m128i v;
+
+		static LaneVec load(const u8* src) noexcept { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)) }; }
+		void store(u8* dst) const noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v); }
+		static LaneVec splat(const u32 value) noexcept { return { _mm_set1_epi8(static_cast<char>(value)) }; }
+
+		friend LaneVec operator+ (const LaneVec a, const LaneVec b) noexcept { return { _mm_add_epi8(a.v, b.v) }; }
+		friend LaneVec operator- (const LaneVec a, const LaneVec b) noexcept { return { _mm_sub_epi8(a.v, b.v) }; }
+		friend LaneVec operator& (const LaneVec a, const LaneVec b) noexcept { return { _mm_and_si128(a.v, b.v) }; }
+		friend LaneVec operator| (const LaneVec a, const LaneVec b) noexcept { return { _mm_or_si128(a.v, b.v) }; }
+		friend LaneVec operator^ (const LaneVec a, const LaneVec b) noexcept { return { _mm_xor_si128(a.v, b.v) }; }
+		friend LaneVec operator==(const LaneVec a, const LaneVec b) noexcept { return { _mm_cmpeq_epi8(a.v, b.v) }; }
+
+		static LaneVec adds(const LaneVec a, const LaneVec b) noexcept { return { _mm_adds_epu8(a.v, b.v) }; }
+		static LaneVec max (const LaneVec a, const LaneVec b) noexcept { return { _mm_max_epu8(a.v, b.v) }; }
+		static LaneVec shr1(const LaneVec a) noexcept {
+			return { _mm_and_si128(_mm_srli_epi16(a.v, 1), _mm_set1_epi8(0x7F)) };
+		}
+		static LaneVec select(const LaneVec m, const LaneVec a, const LaneVec b) noexcept {
+			return { _mm_or_si128(_mm_and_si128(m.v, a.v), _mm_andnot_si128(m.v, b.v)) };
+		}
+		u32 bits() const noexcept { return static_cast<u32>(_mm_movemask_epi8(v)); }
+	#else
+		u8 v;
+
+		static LaneVec load(const u8* src) noexcept { return { *src }; }
+		void store(u8* dst) const noexcept { *dst = v; }
+		static LaneVec splat(const u32 value) noexcept { return { static_cast<u8>(value) }; }
+
+		friend LaneVec operator+ (const LaneVec a, const LaneVec b) noexcept { return { static_cast<u8>(a.v + b.v) }; }
+		friend LaneVec operator- (const LaneVec a, const LaneVec b) noexcept { return { static_cast<u8>(a.v - b.v) }; }
+		friend LaneVec operator& (const LaneVec a, const LaneVec b) noexcept { return { static_cast<u8>(a.v & b.v) }; }
+		friend LaneVec operator| (const LaneVec a, const LaneVec b) noexcept { return { static_cast<u8>(a.v | b.v) }; }
+		friend LaneVec operator^ (const LaneVec a, const LaneVec b) noexcept { return { static_cast<u8>(a.v ^ b.v) }; }
+		friend LaneVec operator==(const LaneVec a, const LaneVec b) noexcept { return { static_cast<u8>(a.v == b.v ? 0xFF : 0) }; }
+
+		static LaneVec adds(const LaneVec a, const LaneVec b) noexcept { return { static_cast<u8>(std::min(a.v + b.v, 0xFF)) }; }
+		static LaneVec max (const LaneVec a, const LaneVec b) noexcept { return { std::max(a.v, b.v) }; }
+		static LaneVec shr1(const LaneVec a) noexcept { return { static_cast<u8>(a.v >> 1) }; }
+		static LaneVec select(const LaneVec m, const LaneVec a, const LaneVec b) noexcept {
+			return { static_cast<u8>(m.v & a.v | ~m.v & b.v) };
+		}
+		u32 bits() const noexcept { return v >> 7; }
+	#endif
+
+		// a >= b, unsigned
+		static LaneVec gte(const LaneVec a, const LaneVec b) noexcept { return max(a, b) == a; }
+		// Lanes where a + b carried out of the byte
+		static LaneVec carry(const LaneVec a, const LaneVec b) noexcept { return (adds(a, b) == a + b) ^ splat(0xFF); }
+	};
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+	constexpr usz cLaneVecBytes{ sizeof(LaneVec) };
+
+	// Run fn on every vector of a lane row
+	template <usz STRIDE, typename F>
+	inline void forEachVec(F&& fn) {
+		static_assert(STRIDE % cLaneVecBytes == 0);
+		for (usz i{ 0 }; i < STRIDE; i += cLaneVecBytes) { fn(i); }
+	}
+
+	// Run fn on every lane set in bits
+	template <typename F>
+	inline void forEachLane(u32 bits, F&& fn) {
+		for (; bits; bits &= bits - 1) { fn(static_cast<usz>(std::countr_zero(bits))); }
+	}
+}
+
+template <usz LANES>
+CHIP8_WIDE<LANES>::CHIP8_WIDE(const std::span<const u8> program, const u32 quirks)
+	: mQuirks{ quirks }
+{
+	static_assert(cStride % cLaneVecBytes == 0);
+
+	for (u32 pos{ 0 }; pos < 80; ++pos)
+		{ mMemoryBank[pos].fill(EmuCores::cFontData[pos]); }
+
+	const auto size{ std::min<usz>(program.size(), cTotalMemory - CHIP8_MODERN::cGameLoadPos) };
+	for (usz pos{ 0 }; pos < size; ++pos)
+		{ mMemoryBank[CHIP8_MODERN::cGameLoadPos + pos].fill(program[pos]); }
+
+	for (usz lane{ 0 }; lane < LANES; ++lane) {
+		progCounter(lane, CHIP8_MODERN::cStartOffset);
+		mLanes[lane].cyclesPerFrame = hasQuirk(CHIP8_MODERN::QUIRK_WAIT_VBLANK)
+			? CHIP8_MODERN::cInstSpeedHi : CHIP8_MODERN::cInstSpeedMax;
+	}
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::seedLane(const usz lane, const u64 seed) {
+	mLanes[lane].Wrand = Well512{ seed };
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::copyDisplay(const usz lane, u32* dest) const noexcept {
+	for (const auto& row : mDisplayBuffer)
+		{ *dest++ = 0xFF000000 | EmuCores::cBitsColor[row[lane]]; }
+}
+
+/*==================================================================*/
+	#pragma region Frame Handling
+/*==================================================================*/
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::processFrame() {
+	u32 runningBits{};
+	mActiveBits = 0;
+
+	for (usz lane{ 0 }; lane < LANES; ++lane) {
+		auto& state{ mLanes[lane] };
+		if (state.cyclesPerFrame == 0) { continue; }
+
+		runningBits |= 1u << lane;
+		++state.totalFrames;
+
+		state.Input.updateKeyStates(state.keyStates);
+
+		if (mDelayTimer[lane]) { --mDelayTimer[lane]; }
+		if (mSoundTimer[lane]) { --mSoundTimer[lane]; }
+
+		handlePreFrameInterrupt(lane);
+
+		state.cycleCount = 0;
+		if (state.cyclesPerFrame > 0) { mActiveBits |= 1u << lane; }
+	}
+
+	instructionLoop();
+
+	forEachLane(runningBits, [&](const usz lane) {
+		mLanes[lane].totalCycles += accountIdleCycles(lane);
+		handleEndFrameInterrupt(lane);
+	});
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::handlePreFrameInterrupt(const usz lane) noexcept {
+	auto& state{ mLanes[lane] };
+	switch (state.interruptType)
+	{
+		case Interrupt::FRAME:
+			state.interruptType  = Interrupt::CLEAR;
+			state.cyclesPerFrame = std::abs(state.cyclesPerFrame);
+			return;
+
+		case Interrupt::SOUND:
+			if (!mSoundTimer[lane]) {
+				state.interruptType  = Interrupt::FINAL;
+				state.cyclesPerFrame = 0;
+			}
+			return;
+	}
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::handleEndFrameInterrupt(const usz lane) noexcept {
+	auto& state{ mLanes[lane] };
+	switch (state.interruptType)
+	{
+		case Interrupt::INPUT:
+			if (state.Input.keyPressed(regV(lane, state.inputReg), state.totalFrames)) {
+				state.interruptType  = Interrupt::CLEAR;
+				state.cyclesPerFrame = std::abs(state.cyclesPerFrame);
+				mSoundTimer[lane]    = 2;
+			}
+			return;
+
+		case Interrupt::ERROR:
+		case Interrupt::FINAL:
+			state.cyclesPerFrame = 0;
+			return;
+	}
+}
+
+template <usz LANES>
+s32  CHIP8_WIDE<LANES>::accountIdleCycles(const usz lane) noexcept {
+	auto& state{ mLanes[lane] };
+	if (!state.idleLoopHit) [[likely]] { return state.cycleCount; }
+
+	const auto skipped{ std::abs(state.cyclesPerFrame) - state.cycleCount };
+	state.idleLoopHit = false;
+	state.idleCycles += skipped;
+	++state.idleFrames;
+	return state.cycleCount + skipped;
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::setInterrupt(const usz lane, const Interrupt type) noexcept {
+	mLanes[lane].interruptType  = type;
+	mLanes[lane].cyclesPerFrame = -std::abs(mLanes[lane].cyclesPerFrame);
+	mActiveBits &= ~(1u << lane);
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::laneError(const usz lane, const char* what, const u32 HI, const u32 LO) {
+	char opcode[8];
+	std::snprintf(opcode, sizeof(opcode), "%02X%02X", HI, LO);
+	blog.stdLogOut("Error :: Lane " + std::to_string(lane) + " :: " + what + opcode);
+	setInterrupt(lane, Interrupt::ERROR);
+}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region Lane Grouping
+/*==================================================================*/
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::instructionLoop() {
+	mGroupBits = 0;
+
+	// set while the group is every active lane and its last step kept it together
+	auto inStep{ false };
+
+	while (mActiveBits) {
+		if (!inStep || mGroupBits != mActiveBits) {
+			auto lead{ static_cast<usz>(std::countr_zero(mActiveBits)) };
+			auto bits{ matchLanes(lead) };
+
+			if (bits != mActiveBits) [[unlikely]] {
+				lead = lowestLane();
+				bits = matchLanes(lead);
+			}
+			if (bits != mGroupBits) { flushGroup(); formGroup(bits); }
+		}
+
+		const auto lead{ static_cast<usz>(std::countr_zero(mGroupBits)) };
+		const auto pos { progCounter(lead) };
+		const auto HI  { memory(lead, pos + 0) };
+		const auto LO  { memory(lead, pos + 1) };
+
+		if (std::has_single_bit(mGroupBits)) {
+			stepLane(lead, HI, LO);
+			++mScalarSteps;
+			inStep = true;
+		} else {
+			inStep = stepGroup(pos, HI, LO);
+			++mGroupSteps;
+		}
+
+		if (++mGroupRun == mGroupLimit) { flushGroup(); }
+	}
+	flushGroup();
+}
+
+// Active lanes at the lead's address that fetch the same opcode
+template <usz LANES>
+u32  CHIP8_WIDE<LANES>::matchLanes(const usz lead) const noexcept {
+	const auto pos{ progCounter(lead) };
+	const auto& rowHI{ mMemoryBank[pos + 0 & cTotalMemory - 1] };
+	const auto& rowLO{ mMemoryBank[pos + 1 & cTotalMemory - 1] };
+
+	const auto pcLo{ LaneVec::splat(mProgCounterLo[lead]) };
+	const auto pcHi{ LaneVec::splat(mProgCounterHi[lead]) };
+	const auto opHI{ LaneVec::splat(rowHI[lead]) };
+	const auto opLO{ LaneVec::splat(rowLO[lead]) };
+
+	u32 bits{};
+	forEachVec<cStride>([&](const usz i) {
+		const auto same{
+			(LaneVec::load(&mProgCounterLo[i]) == pcLo) &
+			(LaneVec::load(&mProgCounterHi[i]) == pcHi) &
+			(LaneVec::load(&rowHI[i]) == opHI) &
+			(LaneVec::load(&rowLO[i]) == opLO)
+		};
+		bits |= same.bits() << i;
+	});
+	return bits & mActiveBits;
+}
+
+template <usz LANES>
+usz  CHIP8_WIDE<LANES>::lowestLane() const noexcept {
+	auto lead{ static_cast<usz>(std::countr_zero(mActiveBits)) };
+	forEachLane(mActiveBits, [&](const usz lane) {
+		if (progCounter(lane) < progCounter(lead)) { lead = lane; }
+	});
+	return lead;
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::formGroup(const u32 bits) noexcept {
+	mGroupBits  = bits;
+	mGroupRun   = 0;
+	mGroupLimit = std::numeric_limits<s32>::max();
+
+	for (usz lane{ 0 }; lane < cStride; ++lane)
+		{ mGroupMask[lane] = bits >> lane & 1 ? 0xFF : 0x00; }
+
+	forEachLane(bits, [&](const usz lane) {
+		const auto& state{ mLanes[lane] };
+		mGroupLimit = std::min(mGroupLimit, state.cyclesPerFrame - state.cycleCount);
+	});
+}
+
+// Credit the group's steps to its lanes, retiring those out of cycles
+template <usz LANES>
+void CHIP8_WIDE<LANES>::flushGroup() noexcept {
+	forEachLane(mGroupBits, [&](const usz lane) {
+		auto& state{ mLanes[lane] };
+		state.cycleCount += mGroupRun;
+		if (state.cycleCount >= state.cyclesPerFrame)
+			{ mActiveBits &= ~(1u << lane); }
+	});
+	mGroupBits = 0;
+	mGroupRun  = 0;
+}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region Group Stepping
+/*==================================================================*/
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::skipGroup(const LaneRow& mask) noexcept {
+	forEachVec<cStride>([&](const usz i) {
+		const auto step{ LaneVec::load(&mask[i]) & LaneVec::splat(2) };
+		const auto lo{ LaneVec::load(&mProgCounterLo[i]) };
+		const auto hi{ LaneVec::load(&mProgCounterHi[i]) };
+		(lo + step).store(&mProgCounterLo[i]);
+		(hi - LaneVec::carry(lo, step)).store(&mProgCounterHi[i]);
+	});
+}
+
+// Returns whether the group lanes are still at the same address
+template <usz LANES>
+bool CHIP8_WIDE<LANES>::stepGroup(const u32 pos, const u32 HI, const u32 LO) {
+	skipGroup(mGroupMask);
+
+	const auto X{ static_cast<s32>(HI & 0xF) };
+	const auto Y{ static_cast<s32>(LO >> 4) };
+
+	// Apply fn to every vector of the group, fn(i, mask)
+	const auto kernel{ [&](auto&& fn) {
+		forEachVec<cStride>([&](const usz i) { fn(i, LaneVec::load(&mGroupMask[i])); });
+	} };
+	// Skip the group lanes for which cond(i) holds, true if all or none did
+	const auto skipIf{ [&](auto&& cond) {
+		alignas(64) LaneRow taken;
+		u32 bits{};
+		kernel([&](const usz i, const LaneVec m) {
+			const auto hit{ cond(i) & m };
+			hit.store(&taken[i]);
+			bits |= hit.bits() << i;
+		});
+		if (bits) { skipGroup(taken); }
+		return bits == 0 || bits == mGroupBits;
+	} };
+	// Set group lanes of a lo/hi register pair to a common value
+	const auto setPair{ [&](LaneRow& lo, LaneRow& hi, const u32 value) {
+		kernel([&](const usz i, const LaneVec m) {
+			LaneVec::select(m, LaneVec::splat(value),      LaneVec::load(&lo[i])).store(&lo[i]);
+			LaneVec::select(m, LaneVec::splat(value >> 8), LaneVec::load(&hi[i])).store(&hi[i]);
+		});
+	} };
+	const auto V{ [&](const s32 idx, const usz i) { return LaneVec::load(&mRegisterV[idx][i]); } };
+	const auto setV{ [&](const s32 idx, const usz i, const LaneVec m, const LaneVec value) {
+		LaneVec::select(m, value, V(idx, i)).store(&mRegisterV[idx][i]);
+	} };
+
+	const auto NN { LaneVec::splat(LO) };
+	const auto NNN{ (HI << 8 | LO) & 0xFFF };
+	const auto one{ LaneVec::splat(1) };
+
+	using enum Opcode;
+	const auto type{ CHIP8_MODERN::cOpcodeTable[HI << 8 | LO] };
+	switch (type) {
+		case _00E0:
+			if (hasQuirk(CHIP8_MODERN::QUIRK_WAIT_VBLANK)) [[unlikely]]
+				{ forEachLane(mGroupBits, [&](const usz lane) { setInterrupt(lane, Interrupt::FRAME); }); }
+			for (auto& row : mDisplayBuffer) {
+				kernel([&](const usz i, const LaneVec m) {
+					LaneVec::select(m, LaneVec::splat(0), LaneVec::load(&row[i])).store(&row[i]);
+				});
+			}
+			break;
+
+		case _1NNN:
+			if (pos == NNN) [[unlikely]] { executeEachLane(type, HI, LO); return false; }
+			if (pos - NNN < CHIP8_MODERN::cIdleLoopLen * 2) {
+				forEachLane(mGroupBits, [&](const usz lane) {
+					if (isIdleLoop(lane, NNN)) [[unlikely]]
+						{ mLanes[lane].idleLoopHit = true; setInterrupt(lane, Interrupt::FRAME); }
+				});
+			}
+			setPair(mProgCounterLo, mProgCounterHi, NNN);
+			break;
+
+		case _3xNN:
+			return skipIf([&](const usz i) { return V(X, i) == NN; });
+		case _4xNN:
+			return skipIf([&](const usz i) { return (V(X, i) == NN) ^ LaneVec::splat(0xFF); });
+		case _5xy0:
+			return skipIf([&](const usz i) { return V(X, i) == V(Y, i); });
+		case _9xy0:
+			return skipIf([&](const usz i) { return (V(X, i) == V(Y, i)) ^ LaneVec::splat(0xFF); });
+
+		case _6xNN:
+			kernel([&](const usz i, const LaneVec m) { setV(X, i, m, NN); });
+			break;
+		case _7xNN:
+			kernel([&](const usz i, const LaneVec m) { setV(X, i, m, V(X, i) + NN); });
+			break;
+
+		case _8xy0:
+			kernel([&](const usz i, const LaneVec m) { setV(X, i, m, V(Y, i)); });
+			break;
+		case _8xy1:
+			kernel([&](const usz i, const LaneVec m) { setV(X, i, m, V(X, i) | V(Y, i)); });
+			break;
+		case _8xy2:
+			kernel([&](const usz i, const LaneVec m) { setV(X, i, m, V(X, i) & V(Y, i)); });
+			break;
+		case _8xy3:
+			kernel([&](const usz i, const LaneVec m) { setV(X, i, m, V(X, i) ^ V(Y, i)); });
+			break;
+		case _8xy4:
+			kernel([&](const usz i, const LaneVec m) {
+				const auto vx{ V(X, i) }, vy{ V(Y, i) };
+				setV(X,   i, m, vx + vy);
+				setV(0xF, i, m, LaneVec::carry(vx, vy) & one);
+			});
+			break;
+		case _8xy5:
+			kernel([&](const usz i, const LaneVec m) {
+				const auto vx{ V(X, i) }, vy{ V(Y, i) };
+				setV(X,   i, m, vx - vy);
+				setV(0xF, i, m, LaneVec::gte(vx, vy) & one);
+			});
+			break;
+		case _8xy7:
+			kernel([&](const usz i, const LaneVec m) {
+				const auto vx{ V(X, i) }, vy{ V(Y, i) };
+				setV(X,   i, m, vy - vx);
+				setV(0xF, i, m, LaneVec::gte(vy, vx) & one);
+			});
+			break;
+		case _8xy6:
+			kernel([&](const usz i, const LaneVec m) {
+				const auto src{ V(hasQuirk(CHIP8_MODERN::QUIRK_SHIFT_VX) ? X : Y, i) };
+				setV(X,   i, m, LaneVec::shr1(src));
+				setV(0xF, i, m, src & one);
+			});
+			break;
+		case _8xyE:
+			kernel([&](const usz i, const LaneVec m) {
+				const auto src{ V(hasQuirk(CHIP8_MODERN::QUIRK_SHIFT_VX) ? X : Y, i) };
+				setV(X,   i, m, src + src);
+				setV(0xF, i, m, LaneVec::gte(src, LaneVec::splat(0x80)) & one);
+			});
+			break;
+
+		case _ANNN:
+			setPair(mRegisterILo, mRegisterIHi, NNN);
+			break;
+
+		case _Fx07:
+			kernel([&](const usz i, const LaneVec m) { setV(X, i, m, LaneVec::load(&mDelayTimer[i])); });
+			break;
+		case _Fx15:
+			kernel([&](const usz i, const LaneVec m) {
+				LaneVec::select(m, V(X, i), LaneVec::load(&mDelayTimer[i])).store(&mDelayTimer[i]);
+			});
+			break;
+		case _Fx1E:
+			kernel([&](const usz i, const LaneVec m) {
+				const auto add{ V(X, i) & m };
+				const auto lo{ LaneVec::load(&mRegisterILo[i]) };
+				const auto hi{ LaneVec::load(&mRegisterIHi[i]) };
+				(lo + add).store(&mRegisterILo[i]);
+				(hi - LaneVec::carry(lo, add)).store(&mRegisterIHi[i]);
+			});
+			break;
+		case _Fx29:
+			kernel([&](const usz i, const LaneVec m) {
+				const auto digit{ V(X, i) & LaneVec::splat(0xF) };
+				const auto quad{ digit + digit + digit + digit };
+				LaneVec::select(m, quad + digit, LaneVec::load(&mRegisterILo[i])).store(&mRegisterILo[i]);
+				LaneVec::select(m, LaneVec::splat(0), LaneVec::load(&mRegisterIHi[i])).store(&mRegisterIHi[i]);
+			});
+			break;
+
+		// opcodes that can't move the group lanes apart
+		case _2NNN: case _CxNN: case _DxyN: case _Fx18: case _Fx65:
+			executeEachLane(type, HI, LO);
+			break;
+
+		default:
+			executeEachLane(type, HI, LO);
+			return false;
+	}
+	return true;
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::executeEachLane(const Opcode type, const u32 HI, const u32 LO) {
+	forEachLane(mGroupBits, [&](const usz lane) { executeLane(lane, type, HI, LO); });
+}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region Scalar Stepping
+/*==================================================================*/
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::stepLane(const usz lane, const u32 HI, const u32 LO) {
+	progCounter(lane, progCounter(lane) + 2);
+	executeLane(lane, CHIP8_MODERN::cOpcodeTable[HI << 8 | LO], HI, LO);
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::executeLane(const usz lane, const Opcode type, const u32 HI, const u32 LO) {
+	auto& state{ mLanes[lane] };
+
+	const auto X  { static_cast<s32>(HI & 0xF) };
+	const auto Y  { static_cast<s32>(LO >> 4) };
+	const auto N  { static_cast<s32>(LO & 0xF) };
+	const auto NNN{ (HI << 8 | LO) & 0xFFF };
+
+	auto& VX{ regV(lane, X) };
+	auto& VY{ regV(lane, Y) };
+	auto& VF{ regV(lane, 0xF) };
+
+	const auto skip{ [&](const bool cond) {
+		if (cond) { progCounter(lane, progCounter(lane) + 2); }
+	} };
+
+	using enum Opcode;
+	switch (type) {
+		case _00E0:
+			if (hasQuirk(CHIP8_MODERN::QUIRK_WAIT_VBLANK)) [[unlikely]]
+				{ setInterrupt(lane, Interrupt::FRAME); }
+			for (auto& row : mDisplayBuffer) { row[lane] = 0; }
+			break;
+		case _00EE:
+			progCounter(lane, state.stackBank[--state.stackTop & 0xF]);
+			break;
+		case _1NNN:
+			if (isIdleLoop(lane, NNN)) [[unlikely]]
+				{ state.idleLoopHit = true; setInterrupt(lane, Interrupt::FRAME); }
+			jumpLaneTo(lane, NNN);
+			break;
+		case _2NNN:
+			state.stackBank[state.stackTop++ & 0xF] = static_cast<u16>(progCounter(lane));
+			jumpLaneTo(lane, NNN);
+			break;
+		case _3xNN: skip(VX == LO); break;
+		case _4xNN: skip(VX != LO); break;
+		case _5xy0: skip(VX == VY); break;
+		case _6xNN: VX  = static_cast<u8>(LO); break;
+		case _7xNN: VX += static_cast<u8>(LO); break;
+		case _8xy0: VX  = VY; break;
+		case _8xy1: VX |= VY; break;
+		case _8xy2: VX &= VY; break;
+		case _8xy3: VX ^= VY; break;
+		case _8xy4: {
+			const auto sum{ VX + VY };
+			VX = static_cast<u8>(sum);
+			VF = static_cast<u8>(sum >> 8);
+		} break;
+		case _8xy5: {
+			const bool nborrow{ VX >= VY };
+			VX = static_cast<u8>(VX - VY);
+			VF = nborrow;
+		} break;
+		case _8xy7: {
+			const bool nborrow{ VY >= VX };
+			VX = static_cast<u8>(VY - VX);
+			VF = nborrow;
+		} break;
+		case _8xy6: {
+			if (!hasQuirk(CHIP8_MODERN::QUIRK_SHIFT_VX)) { VX = VY; }
+			const bool lsb{ (VX & 1) == 1 };
+			VX = static_cast<u8>(VX >> 1);
+			VF = lsb;
+		} break;
+		case _8xyE: {
+			if (!hasQuirk(CHIP8_MODERN::QUIRK_SHIFT_VX)) { VX = VY; }
+			const bool msb{ (VX >> 7) == 1 };
+			VX = static_cast<u8>(VX << 1);
+			VF = msb;
+		} break;
+		case _9xy0: skip(VX != VY); break;
+		case _ANNN: registerI(lane, NNN); break;
+		case _BNNN: jumpLaneTo(lane, NNN + regV(lane, 0)); break;
+		case _CxNN: VX = static_cast<u8>(state.Wrand.get() & LO); break;
+		case _DxyN: drawSprite(lane, X, Y, N); break;
+		case _Ex9E: skip( state.Input.keyHeld_P1(VX)); break;
+		case _ExA1: skip(!state.Input.keyHeld_P1(VX)); break;
+		case _Fx07: VX = mDelayTimer[lane]; break;
+		case _Fx0A:
+			setInterrupt(lane, Interrupt::INPUT);
+			state.inputReg = static_cast<u8>(X);
+			break;
+		case _Fx15: mDelayTimer[lane] = VX; break;
+		case _Fx18: mSoundTimer[lane] = static_cast<u8>(VX + (VX == 1)); break;
+		case _Fx1E: registerI(lane, registerI(lane) + VX & 0xFFFF); break;
+		case _Fx29: registerI(lane, (VX & 0xF) * 5); break;
+		case _Fx33: {
+			const auto value{ VX };
+			const auto I{ registerI(lane) };
+			memory(lane, I + 0) = static_cast<u8>(value / 100);
+			memory(lane, I + 1) = static_cast<u8>(value / 10 % 10);
+			memory(lane, I + 2) = static_cast<u8>(value      % 10);
+		} break;
+		case _Fx55: {
+			const auto I{ registerI(lane) };
+			for (auto idx{ 0 }; idx <= X; ++idx)
+				{ memory(lane, I + idx) = regV(lane, idx); }
+			if (!hasQuirk(CHIP8_MODERN::QUIRK_IDX_REG_NOINC)) [[likely]]
+				{ registerI(lane, I + X + 1 & 0xFFFF); }
+		} break;
+		case _Fx65: {
+			const auto I{ registerI(lane) };
+			for (auto idx{ 0 }; idx <= X; ++idx)
+				{ regV(lane, idx) = memory(lane, I + idx); }
+			if (!hasQuirk(CHIP8_MODERN::QUIRK_IDX_REG_NOINC)) [[likely]]
+				{ registerI(lane, I + X + 1 & 0xFFFF); }
+		} break;
+		[[unlikely]]
+		case ERROR_00NN: laneError(lane, "ML routines unsupported: ", HI, LO); break;
+		[[unlikely]]
+		default:         laneError(lane, "Unknown instruction: ",     HI, LO); break;
+	}
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::jumpLaneTo(const usz lane, const u32 next) noexcept {
+	if (progCounter(lane) - 2 == next) [[unlikely]] {
+		setInterrupt(lane, Interrupt::SOUND);
+	} else { progCounter(lane, next & 0xFFFF); }
+}
+
+// Same test as CHIP8_MODERN::testIdleLoop, run on one lane
+template <usz LANES>
+bool CHIP8_WIDE<LANES>::isIdleLoop(const usz lane, const u32 head) noexcept {
+	const auto tail{ progCounter(lane) };
+	const auto span{ static_cast<s32>(tail - 2 - head) };
+	if (span <= 0 || span >= CHIP8_MODERN::cIdleLoopLen * 2) { return false; }
+
+	u8 tailRegisterV[16];
+	for (auto idx{ 0 }; idx < 16; ++idx) { tailRegisterV[idx] = regV(lane, idx); }
+
+	auto pure{ true };
+	auto pos { head };
+	progCounter(lane, head);
+	while (pure && pos < tail - 2) {
+		const auto HI{ memory(lane, pos + 0) };
+		const auto LO{ memory(lane, pos + 1) };
+		const auto type{ CHIP8_MODERN::cOpcodeTable[HI << 8 | LO] };
+		progCounter(lane, pos + 2);
+
+		using enum Opcode;
+		switch (type) {
+			case _3xNN: case _4xNN: case _5xy0: case _6xNN:
+			case _9xy0: case _Ex9E: case _ExA1: case _Fx07:
+				executeLane(lane, type, HI, LO);
+				break;
+			default:
+				pure = false;
+				break;
+		}
+		pos = progCounter(lane);
+	}
+
+	auto idle{ pure && pos == tail - 2 };
+	for (auto idx{ 0 }; idx < 16; ++idx) {
+		if (regV(lane, idx) != tailRegisterV[idx]) { idle = false; }
+		regV(lane, idx) = tailRegisterV[idx];
+	}
+	progCounter(lane, tail);
+	return idle;
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::drawByte(const usz lane, s32 X, const s32 Y, const u32 DATA) noexcept {
+	const auto wrap{ hasQuirk(CHIP8_MODERN::QUIRK_WRAP_SPRITE) };
+	const auto flip{ [&](const s32 pX) {
+		if (!(mDisplayBuffer[Y * 64 + pX][lane] ^= 1)) { regV(lane, 0xF) = 1; }
+	} };
+
+	switch (DATA) {
+		case 0b00000000:
+			return;
+		case 0b10000000:
+			if (wrap) { X &= 63; }
+			if (X < 64) { flip(X); }
+			return;
+		default:
+			if (wrap) { X &= 63; }
+			else if (X >= 64) { return; }
+
+			for (auto B{ 0 }; B < 8; ++X &= 63) {
+				if (DATA & 0x80 >> B++) { flip(X); }
+				if (!wrap && X == 63) { return; }
+			}
+			return;
+	}
+}
+
+template <usz LANES>
+void CHIP8_WIDE<LANES>::drawSprite(const usz lane, const s32 X, const s32 Y, const s32 N) noexcept {
+	if (hasQuirk(CHIP8_MODERN::QUIRK_WAIT_VBLANK)) [[unlikely]]
+		{ setInterrupt(lane, Interrupt::FRAME); }
+
+	const auto wrap{ hasQuirk(CHIP8_MODERN::QUIRK_WRAP_SPRITE) };
+	const auto I{ registerI(lane) };
+
+	auto pX{ regV(lane, X) & 63 };
+	auto pY{ regV(lane, Y) & 31 };
+
+	regV(lane, 0xF) = 0;
+
+	switch (N) {
+		case 1:
+			drawByte(lane, pX, pY, memory(lane, I));
+			break;
+		case 0:
+			for (auto H{ 0 }, idx{ 0 }; H < 16; ++H, ++pY &= 31) {
+				drawByte(lane, pX + 0, pY, memory(lane, I + idx++));
+				drawByte(lane, pX + 8, pY, memory(lane, I + idx++));
+				if (!wrap && pY == 31) { break; }
+			}
+			break;
+		default:
+			for (auto H{ 0 }; H < N; ++H, ++pY &= 31) {
+				drawByte(lane, pX, pY, memory(lane, I + H));
+				if (!wrap && pY == 31) { break; }
+			}
+			break;
+	}
+}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+template class CHIP8_WIDE<8>;
+template class CHIP8_WIDE<16>;
+template class CHIP8_WIDE<32>;
@@ -0,0 +1,176 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <span>
+#include <array>
+#include <algorithm>
+
+#include "../../Assistants/Well512.hpp"
+#include "../DispatchEngine.hpp"
+#include "../HexInput.hpp"
+#include "../Enums.hpp"
+#include "CHIP8_MODERN.hpp"
+
+/*
+	Runs LANES instances of the same CHIP8_MODERN program side by side,
+	each with its own RNG seed and key states, for fuzzing and sweeps.
+
+	Registers, timers, memory and display are kept lane-interleaved, so
+	one vector op steps every lane sitting on the same opcode. Lanes at
+	different addresses are split into groups and stepped group by group,
+	lowest address first so they can merge again, and a group of one runs
+	the scalar interpreter. Opcodes bound to per-lane state (sprites, RNG,
+	keys, stack, indexed memory) run the scalar path for each group lane.
+*/
+
+template <usz LANES>
+class CHIP8_WIDE final {
+	static_assert(LANES == 8 || LANES == 16 || LANES == 32, "lanes must be 8, 16 or 32");
+
+	using Opcode = CHIP8_MODERN::Opcode;
+
+	static constexpr u32 cTotalMemory{ CHIP8_MODERN::cTotalMemory };
+	static constexpr u32 cDisplaySize{ 64 * 32 };
+
+#if defined(CUBECHIP_WIDE_AVX2)
+	static constexpr usz cVectorBytes{ 32 };
+#elif defined(CUBECHIP_WIDE_SSE2)
+	static constexpr usz cVectorBytes{ 16 };
+#else
+	static constexpr usz cVectorBytes{  1 };
+#endif
+
+	// Lanes per row, padded to whole vectors, padding lanes never run
+	static constexpr usz cStride{ std::max(LANES, cVectorBytes) };
+
+	using LaneRow = std::array<u8, cStride>;
+
+public:
+	static constexpr bool testGameSize(const usz size) noexcept {
+		return CHIP8_MODERN::testGameSize(size);
+	}
+
+	explicit CHIP8_WIDE(std::span<const u8> program, u32 quirks = 0);
+
+	void seedLane(usz lane, u64 seed);
+	void setLaneKeys(usz lane, u32 keyStates) noexcept { mLanes[lane].keyStates = keyStates; }
+
+	void processFrame();
+
+	[[nodiscard]] bool isLaneStopped(const usz lane) const noexcept { return mLanes[lane].cyclesPerFrame == 0; }
+	[[nodiscard]] bool isSystemStopped() const noexcept {
+		return std::all_of(mLanes.begin(), mLanes.end(),
+			[](const auto& lane) noexcept { return lane.cyclesPerFrame == 0; });
+	}
+
+	auto getTotalFrames(const usz lane) const noexcept { return mLanes[lane].totalFrames; }
+	auto getTotalCycles(const usz lane) const noexcept { return mLanes[lane].totalCycles; }
+	auto getIdleFrames(const usz lane)  const noexcept { return mLanes[lane].idleFrames; }
+	auto getIdleCycles(const usz lane)  const noexcept { return mLanes[lane].idleCycles; }
+
+	// Steps taken by groups of several lanes vs a single lane
+	auto getGroupSteps()  const noexcept { return mGroupSteps; }
+	auto getScalarSteps() const noexcept { return mScalarSteps; }
+
+	// Write the display of a lane as ARGB pixels, like CHIP8_MODERN's texture
+	void copyDisplay(usz lane, u32* dest) const noexcept;
+
+private:
+	// Per-lane state only touched by scalar code
+	struct LaneState final {
+		Well512  Wrand;
+		HexInput Input;
+
+		u64 totalCycles{}, idleCycles{};
+		u32 totalFrames{}, idleFrames{};
+
+		s32 cyclesPerFrame{};
+		s32 cycleCount{};
+		u32 keyStates{};
+
+		Interrupt interruptType{ Interrupt::CLEAR };
+		bool idleLoopHit{};
+
+		u8  inputReg{};
+		u8  stackTop{};
+		u16 stackBank[16]{};
+	};
+
+	std::array<LaneState, LANES> mLanes;
+
+	alignas(64) LaneRow mRegisterV[16]{};
+	alignas(64) LaneRow mProgCounterLo{};
+	alignas(64) LaneRow mProgCounterHi{};
+	alignas(64) LaneRow mRegisterILo{};
+	alignas(64) LaneRow mRegisterIHi{};
+	alignas(64) LaneRow mDelayTimer{};
+	alignas(64) LaneRow mSoundTimer{};
+
+	alignas(64) std::array<LaneRow, cTotalMemory> mMemoryBank{};
+	alignas(64) std::array<LaneRow, cDisplaySize> mDisplayBuffer{};
+
+	u32 mQuirks{};
+
+	u32 mActiveBits{}; // lanes with cycles left this frame
+	u32 mGroupBits{};  // lanes of the group being stepped
+	s32 mGroupRun{};   // steps taken by the group, not yet added to its lanes
+	s32 mGroupLimit{}; // steps until a group lane runs out of cycles
+
+	alignas(64) LaneRow mGroupMask{}; // mGroupBits as 0x00/0xFF bytes
+
+	u64 mGroupSteps{};
+	u64 mScalarSteps{};
+
+	bool hasQuirk(const u32 bit) const noexcept { return mQuirks & bit; }
+
+	auto& regV(const usz lane, const s32 X) noexcept { return mRegisterV[X][lane]; }
+	u8&   memory(const usz lane, const u32 pos) noexcept { return mMemoryBank[pos & cTotalMemory - 1][lane]; }
+
+	u32  progCounter(const usz lane) const noexcept { return mProgCounterHi[lane] << 8 | mProgCounterLo[lane]; }
+	void progCounter(const usz lane, const u32 pos) noexcept {
+		mProgCounterLo[lane] = static_cast<u8>(pos);
+		mProgCounterHi[lane] = static_cast<u8>(pos >> 8);
+	}
+	u32  registerI(const usz lane) const noexcept { return mRegisterIHi[lane] << 8 | mRegisterILo[lane]; }
+	void registerI(const usz lane, const u32 pos) noexcept {
+		mRegisterILo[lane] = static_cast<u8>(pos);
+		mRegisterIHi[lane] = static_cast<u8>(pos >> 8);
+	}
+
+	void setInterrupt(usz lane, Interrupt) noexcept;
+	void laneError(usz lane, const char* what, u32 HI, u32 LO);
+
+	void handlePreFrameInterrupt(usz lane) noexcept;
+	void handleEndFrameInterrupt(usz lane) noexcept;
+	s32  accountIdleCycles(usz lane) noexcept;
+
+	void instructionLoop();
+
+	u32  matchLanes(usz lead) const noexcept;
+	usz  lowestLane() const noexcept;
+	void formGroup(u32 bits) noexcept;
+	void flushGroup() noexcept;
+
+	void stepLane(usz lane, u32 HI, u32 LO);
+	bool stepGroup(u32 pos, u32 HI, u32 LO);
+
+	void executeLane(usz lane, Opcode, u32 HI, u32 LO);
+	void executeEachLane(Opcode, u32 HI, u32 LO);
+
+	// Add 2 to the program counter of the group lanes set in given mask
+	void skipGroup(const LaneRow& mask) noexcept;
+
+	void jumpLaneTo(usz lane, u32 next) noexcept;
+	bool isIdleLoop(usz lane, u32 head) noexcept;
+	void drawByte(usz lane, s32 X, s32 Y, u32 DATA) noexcept;
+	void drawSprite(usz lane, s32 X, s32 Y, s32 N) noexcept;
+};
+
+extern template class CHIP8_WIDE<8>;
+extern template class CHIP8_WIDE<16>;
+extern template class CHIP8_WIDE<32>;
@@ -5,8 +5,10 @@
 */
 
 #include <fstream>
+#include <filesystem>
 #include <sstream>
 #include <iomanip>
+#include <cstring>
 
 #include "EmuCores.hpp"
 #include "../Enums.hpp"
@@ -15,6 +17,7 @@
 #include "../../HostClass/BasicVideoSpec.hpp"
 #include "../../HostClass/BasicAudioSpec.hpp"
 
+#include "../../Assistants/MappedFile.hpp"
 #include "../../Assistants/BasicLogger.hpp"
 using namespace blogger;
 
@@ -34,6 +37,21 @@ void EmuCores::setInterrupt(const Interrupt type) {
 	mCyclesPerFrame = -std::abs(mCyclesPerFrame);
 }
 
+void EmuCores::skipIdleLoop() {
+	mIdleLoopHit = true;
+	setInterrupt(Interrupt::FRAME);
+}
+
+s32  EmuCores::accountIdleCycles(const s32 cycleCount) noexcept {
+	if (!mIdleLoopHit) [[likely]] { return cycleCount; }
+
+	const auto skipped{ std::abs(mCyclesPerFrame) - cycleCount };
+	mIdleLoopHit = false;
+	mIdleCycles += skipped;
+	++mIdleFrames;
+	return cycleCount + skipped;
+}
+
 void EmuCores::operationError(std::string_view msg) {
 	blog.stdLogOut(msg.data());
 	setInterrupt(Interrupt::ERROR);
@@ -75,11 +93,288 @@ void EmuCores::copyFontToMemory(u8* dest, const u32 offset, const u32 size) {
 	);
 }
 
+bool EmuCores::readPermRegs(u8* dest, const usz count) {
+	const auto path{ HDM.permRegs / HDM.sha1 };
+
+	if (std::filesystem::exists(path)) {
+		if (!std::filesystem::is_regular_file(path)) {
+			blog.stdLogOut("SHA1 file is malformed: " + path.string());
+			return true;
+		}
+
+		std::ifstream in(path, std::ios::binary);
+		if (in.is_open()) {
+			in.seekg(0, std::ios::end);
+			const auto totalBytes{ static_cast<usz>(in.tellg()) };
+			in.seekg(0, std::ios::beg);
+
+			in.read(reinterpret_cast<char*>(dest), std::min(totalBytes, count));
+			in.close();
+
+			if (totalBytes < count) {
+				std::fill_n(dest + totalBytes, count - totalBytes, u8());
+			}
+		} else {
+			blog.stdLogOut("Could not open SHA1 file to read: " + path.string());
+			return true;
+		}
+	} else {
+		std::fill_n(dest, count, u8());
+	}
+	return false;
+}
+
+bool EmuCores::writePermRegs(const u8* src, const usz count) {
+	const auto path{ HDM.permRegs / HDM.sha1 };
+
+	char tempV[16]{};
+	if (std::filesystem::exists(path)) {
+		if (!std::filesystem::is_regular_file(path)) {
+			blog.stdLogOut("SHA1 file is malformed: " + path.string());
+			return true;
+		}
+
+		std::ifstream in(path, std::ios::binary);
+		if (in.is_open()) {
+			in.seekg(0, std::ios::end);
+			const auto totalBytes{ in.tellg() };
+			in.seekg(0, std::ios::beg);
+
+			in.read(tempV, std::min<std::streamsize>(totalBytes, 16));
+			in.close();
+		} else {
+			blog.stdLogOut("Could not open SHA1 file to read: " + path.string());
+			return true;
+		}
+	}
+
+	std::copy_n(src, count, tempV);
+
+	std::ofstream out(path, std::ios::binary);
+	if (out.is_open()) {
+		out.write(tempV, 16);
+		out.close();
+	} else {
+		blog.stdLogOut("Could not open SHA1 file to write: " + path.string());
+		return true;
+	}
+	return false;
+}
+
+usz  EmuCores::fixedStateSize() const noexcept {
+	return sizeof(StateHeader) + sizeof(SharedState) + coreStateSize();
+}
+
+usz  EmuCores::stateSize() const noexcept {
+	return coreStateSize() ? fixedStateSize() + Pages.size() : 0;
+}
+
+bool EmuCores::stateFits(const usz size) const {
+	const auto totalSize{ stateSize() };
+	if (!totalSize) {
+		blog.stdLogOut("Save states are not supported by this core");
+		return false;
+	}
+	if (size < totalSize) {
+		blog.stdLogOut("Save state does not fit in " + std::to_string(size) + " bytes");
+		return false;
+	}
+	return true;
+}
+
+bool EmuCores::stateMatches(const std::span<const u8> src) const {
+	const auto totalSize{ stateSize() };
+	if (!totalSize) {
+		blog.stdLogOut("Save states are not supported by this core");
+		return false;
+	}
+
+	StateHeader header{};
+	if (src.size() >= sizeof(header)) {
+		std::memcpy(&header, src.data(), sizeof(header));
+	}
+	if (src.size() < totalSize
+		|| !std::equal(cStateMagic, cStateMagic + sizeof(header.magic), header.magic)
+		|| header.version    != cStateVersion
+		|| header.sharedSize != sizeof(SharedState)
+		|| header.coreSize   != coreStateSize()
+		|| header.pagedSize  != Pages.size()
+	) {
+		blog.stdLogOut("Save state is malformed or from another version");
+		return false;
+	}
+	if (std::string_view{ header.sha1, strnlen(header.sha1, sizeof(header.sha1)) } != HDM.sha1) {
+		blog.stdLogOut("Save state belongs to another rom");
+		return false;
+	}
+	return true;
+}
+
+void EmuCores::saveFixedState(u8* dest) const {
+	StateHeader header{
+		.version    = cStateVersion,
+		.sharedSize = sizeof(SharedState),
+		.coreSize   = static_cast<u32>(coreStateSize()),
+		.pagedSize  = static_cast<u32>(Pages.size()),
+	};
+	std::copy_n(cStateMagic, sizeof(header.magic), header.magic);
+	std::copy_n(HDM.sha1.data(), std::min(HDM.sha1.size(), sizeof(header.sha1)), header.sha1);
+
+	const SharedState shared{
+		.totalCycles    = mTotalCycles,
+		.idleCycles     = mIdleCycles,
+		.totalFrames    = mTotalFrames,
+		.idleFrames     = mIdleFrames,
+		.cyclesPerFrame = mCyclesPerFrame,
+		.interruptType  = mInterruptType,
+		.idleLoopHit    = mIdleLoopHit,
+		.Wrand          = Wrand,
+		.keyStates      = Input.saveKeyStates(),
+	};
+
+	std::memcpy(dest, &header, sizeof(header)); dest += sizeof(header);
+	std::memcpy(dest, &shared, sizeof(shared)); dest += sizeof(shared);
+	saveCoreState(dest);
+}
+
+void EmuCores::loadFixedState(const u8* src) {
+	SharedState shared;
+	std::memcpy(&shared, src + sizeof(StateHeader), sizeof(shared));
+
+	mTotalCycles    = shared.totalCycles;
+	mIdleCycles     = shared.idleCycles;
+	mTotalFrames    = shared.totalFrames;
+	mIdleFrames     = shared.idleFrames;
+	mCyclesPerFrame = shared.cyclesPerFrame;
+	mInterruptType  = shared.interruptType;
+	mIdleLoopHit    = shared.idleLoopHit;
+	Wrand           = shared.Wrand;
+	Input.loadKeyStates(shared.keyStates);
+
+	loadCoreState(src + sizeof(StateHeader) + sizeof(shared));
+}
+
+void EmuCores::loadPagedState(const u8* src, const u32 stamp) {
+	auto* const memory{ Pages.data() };
+	src += fixedStateSize();
+
+	// pages left as they were need not be seen as written by whoever saves next
+	Pages.forEachSince(stamp, [&](const usz offset, const usz size) {
+		for (auto page{ offset }; page < offset + size; page += PageTracker::cPageSize) {
+			const auto length{ std::min(PageTracker::cPageSize, offset + size - page) };
+			if (std::memcmp(memory + page, src + page, length)) {
+				std::memcpy(memory + page, src + page, length);
+				Pages.touch(page);
+			}
+		}
+	});
+}
+
+bool EmuCores::saveState(const std::span<u8> dest) const {
+	if (!stateFits(dest.size())) { return false; }
+
+	saveFixedState(dest.data());
+	std::copy_n(Pages.data(), Pages.size(), dest.data() + fixedStateSize());
+	return true;
+}
+
+bool EmuCores::loadState(const std::span<const u8> src) {
+	if (!stateMatches(src)) { return false; }
+
+	loadPagedState(src.data(), 0);
+	loadFixedState(src.data());
+	return true;
+}
+
+u32  EmuCores::saveStateSince(const std::span<u8> dest, const u32 stamp, StateRanges* ranges) {
+	if (!stateFits(dest.size())) { return 0; }
+
+	const auto fixedSize{ fixedStateSize() };
+	saveFixedState(dest.data());
+	if (ranges) { ranges->assign(1, { 0, fixedSize }); }
+
+	Pages.forEachSince(stamp, [&](const usz offset, const usz size) {
+		std::copy_n(Pages.data() + offset, size, dest.data() + fixedSize + offset);
+		if (!ranges) { return; }
+
+		auto& last{ ranges->back() };
+		if (last.first + last.second == fixedSize + offset) {
+			last.second += size;
+		} else {
+			ranges->emplace_back(fixedSize + offset, size);
+		}
+	});
+	return Pages.mark();
+}
+
+bool EmuCores::loadStateSince(const std::span<const u8> src, const u32 stamp) {
+	if (!stateMatches(src)) { return false; }
+
+	loadPagedState(src.data(), stamp);
+	loadFixedState(src.data());
+	return true;
+}
+
+bool EmuCores::saveStateFile() const {
+	const auto totalSize{ stateSize() };
+	if (!totalSize) {
+		blog.stdLogOut("Save states are not supported by this core");
+		return false;
+	}
+
+	const auto path{ HDM.saveStates / HDM.sha1 };
+	const MappedFile file{ path, totalSize };
+	if (!file.valid()) {
+		blog.stdLogOut("Could not map state file to write: " + path.string());
+		return false;
+	}
+	return saveState(file.data());
+}
+
+bool EmuCores::loadStateFile() {
+	const auto path{ HDM.saveStates / HDM.sha1 };
+	if (!std::filesystem::is_regular_file(path)) {
+		blog.stdLogOut("No save state found: " + path.string());
+		return false;
+	}
+
+	const MappedFile file{ path };
+	if (!file.valid()) {
+		blog.stdLogOut("Could not map state file to read: " + path.string());
+		return false;
+	}
+	return loadState(file.data());
+}
+
+bool EmuCores::runAhead(const u32 frames, const std::span<u8> buffer, u32& stamp) {
+	if (!frames || !stateSize()) { return false; }
+
+	stamp = saveStateSince(buffer, stamp);
+	if (!stamp) { return false; }
+
+	mRunningAhead = true;
+	for (auto frame{ 0u }; frame < frames; ++frame) {
+		processFrame();
+	}
+	const auto restored{ loadStateSince(buffer, stamp) };
+	mRunningAhead = false;
+	return restored;
+}
+
 bool VM_Guest::initGameCore(
 	HomeDirManager& HDM,
 	BasicVideoSpec& BVS,
 	BasicAudioSpec& BAS
 ) {
-	mCoreBase = std::move(GameFileChecker::initializeCore(HDM, BVS, BAS));
+	mPristine.park(std::move(mCoreBase));
+	mCoreBase = mPristine.fetch(HDM, BVS, BAS);
+	mRewind.reset(
+		mCoreBase ? mCoreBase->stateSize() : 0,
+		static_cast<usz>(cRewindSeconds * fetchFramerate()),
+		cRewindBytes
+	);
+	mAheadState.resize(mCoreBase ? mCoreBase->stateSize() : 0);
+	mAheadStamp = 0;
+	if (mAheadState.empty()) { mRunAhead = 0; }
 	return mCoreBase ? true : false;
 }
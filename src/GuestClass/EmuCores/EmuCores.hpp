@@ -8,16 +8,24 @@
 
 #include "../../Assistants/Well512.hpp"
 #include "../../Assistants/Map2D.hpp"
+#include "../../Assistants/PageTracker.hpp"
 #include "../../Types.hpp"
 
 #include "../GameFileChecker.hpp"
+#include "../PristineCache.hpp"
+#include "../RewindBuffer.hpp"
 #include "../HexInput.hpp"
 #include "../Enums.hpp"
 
+#include <array>
 #include <utility>
+#include <algorithm>
 #include <cstddef>
+#include <limits>
 #include <memory>
 #include <string>
+#include <span>
+#include <vector>
 
 class HomeDirManager;
 class BasicVideoSpec;
@@ -39,8 +47,51 @@ protected:
 		bool waitVblank{};
 		bool waitScroll{};
 		bool wrapSprite{};
+
+		constexpr u32 mask() const noexcept {
+			return clearVF     << 0 | jmpRegX     << 1
+				|  shiftVX     << 2 | idxRegNoInc << 3
+				|  idxRegMinus << 4 | waitVblank  << 5
+				|  waitScroll  << 6 | wrapSprite  << 7;
+		}
 	} Quirk;
 
+	// Quirk bits matching PlatformQuirks::mask() for cores specialized on them
+	enum QuirkBit : u32 {
+		QUIRK_CLEAR_VF      = 1 << 0,
+		QUIRK_JMP_REG_X     = 1 << 1,
+		QUIRK_SHIFT_VX      = 1 << 2,
+		QUIRK_IDX_REG_NOINC = 1 << 3,
+		QUIRK_IDX_REG_MINUS = 1 << 4,
+		QUIRK_WAIT_VBLANK   = 1 << 5,
+		QUIRK_WAIT_SCROLL   = 1 << 6,
+		QUIRK_WRAP_SPRITE   = 1 << 7,
+		QUIRK_RUNTIME       = 1u << 31, // test the Quirk flags instead
+	};
+
+	static constexpr auto quirkField(const u32 bit) noexcept {
+		switch (bit) {
+			case QUIRK_CLEAR_VF:      return &PlatformQuirks::clearVF;
+			case QUIRK_JMP_REG_X:     return &PlatformQuirks::jmpRegX;
+			case QUIRK_SHIFT_VX:      return &PlatformQuirks::shiftVX;
+			case QUIRK_IDX_REG_NOINC: return &PlatformQuirks::idxRegNoInc;
+			case QUIRK_IDX_REG_MINUS: return &PlatformQuirks::idxRegMinus;
+			case QUIRK_WAIT_VBLANK:   return &PlatformQuirks::waitVblank;
+			case QUIRK_WAIT_SCROLL:   return &PlatformQuirks::waitScroll;
+			default:                  return &PlatformQuirks::wrapSprite;
+		}
+	}
+
+	// Test a quirk either fixed at compile time by QUIRKS or at runtime
+	template <u32 QUIRKS, u32 BIT>
+	bool testQuirk() const noexcept {
+		if constexpr (QUIRKS & QUIRK_RUNTIME) {
+			return Quirk.*quirkField(BIT);
+		} else {
+			return QUIRKS & BIT;
+		}
+	}
+
 	using enum Interrupt;
 	Interrupt mInterruptType{ CLEAR };
 
@@ -49,6 +100,12 @@ protected:
 	u64  mTotalCycles{};
 	u32  mTotalFrames{};
 
+	u64  mIdleCycles{};
+	u32  mIdleFrames{};
+	bool mIdleLoopHit{};
+
+	bool mRunningAhead{}; // frames are speculative, their audio is not played
+
 	s32  mCyclesPerFrame{};
 	s32  boost{};
 
@@ -62,6 +119,20 @@ protected:
 		mDisplayH = H; mDisplayHb = H - 1;
 	}
 
+	// Display rows changed since the texture was last drawn, none if first > last
+	s32 mDirtyFirst{ std::numeric_limits<s32>::max() };
+	s32 mDirtyLast{ -1 };
+
+	void markRowDirty(const s32 row) noexcept {
+		mDirtyFirst = std::min(mDirtyFirst, row);
+		mDirtyLast  = std::max(mDirtyLast,  row);
+	}
+	void markAllDirty() noexcept { mDirtyFirst = 0; mDirtyLast = mDisplayHb; }
+	void clearDirty() noexcept {
+		mDirtyFirst = std::numeric_limits<s32>::max();
+		mDirtyLast  = -1;
+	}
+
 	bool mLoresExtended{};
 	bool mManualRefresh{};
 	bool mPixelTrailing{};
@@ -85,6 +156,10 @@ protected:
 	Well512  Wrand;
 	HexInput Input;
 
+	// Memory saved with the states of the core, by pages so that keeping a
+	// state up to date only copies those written since it was last saved
+	PageTracker Pages;
+
 	std::string formatOpcode(const u32 HI, const u32 LO) const;
 
 	void setInterrupt(Interrupt);
@@ -92,9 +167,99 @@ protected:
 	void instructionError(const u32 HI, const u32 LO);
 	void instructionErrorML(const u32 HI, const u32 LO);
 
+	void skipIdleLoop();
+	s32  accountIdleCycles(const s32 cycleCount) noexcept;
+
 	bool copyGameToMemory(u8* dest, const u32 offset);
 	void copyFontToMemory(u8* dest, const u32 offset, const u32 size);
 
+	// Classify every 16-bit opcode at compile time, invalid ones included
+	template <typename T, typename F>
+	static consteval auto makeOpcodeTable(F classify) {
+		std::array<T, 0x10000> table{};
+		for (auto opcode{ 0u }; opcode < table.size(); ++opcode)
+			{ table[opcode] = classify(opcode >> 8, opcode & 0xFF); }
+		return table;
+	}
+
+	bool readPermRegs(u8* dest, const usz count);
+	bool writePermRegs(const u8* src, const usz count);
+
+	static constexpr char cStateMagic[4]{ 'C', 'C', 'S', 'T' };
+	static constexpr u32  cStateVersion{ 3 }; // bump on any change to a state layout
+
+	// Leads every save state, followed by SharedState, the core's block and its paged memory
+	struct StateHeader final {
+		char magic[4];
+		u32  version;
+		u32  sharedSize;
+		u32  coreSize;
+		u32  pagedSize;
+		char sha1[40]; // rom the state was taken from
+	};
+
+	// Machine state kept in EmuCores itself, common to all cores
+	struct SharedState final {
+		u64 totalCycles;
+		u64 idleCycles;
+		u32 totalFrames;
+		u32 idleFrames;
+		s32 cyclesPerFrame;
+		Interrupt interruptType;
+		bool idleLoopHit;
+		u8   reserved[3]; // spelled out so no stray padding bytes end up in states
+		Well512 Wrand;
+		HexInput::KeyStates keyStates;
+	};
+
+	// Size of the core's own state block, 0 if the core has no save states
+	virtual usz  coreStateSize() const noexcept { return 0; }
+	virtual void saveCoreState(u8*) const noexcept {}
+	virtual void loadCoreState(const u8*) {}
+
+private:
+	usz  fixedStateSize() const noexcept;
+	bool stateFits(usz size) const;
+	bool stateMatches(std::span<const u8> src) const;
+
+	void saveFixedState(u8* dest) const;
+	void loadFixedState(const u8* src);
+	void loadPagedState(const u8* src, u32 stamp);
+
+protected:
+
+	// Shift a W*H buffer by given rows/cols, clearing the area left behind
+	template <typename T>
+	static void shiftBuffer(T* buffer, const s32 W, const s32 H, const s32 rows, const s32 cols) {
+		if (rows > 0) {
+			std::copy_backward(buffer, buffer + (H - std::min(rows, H)) * W, buffer + H * W);
+			std::fill_n(buffer, std::min(rows, H) * W, T());
+		} else if (rows < 0) {
+			std::copy(buffer + std::min(-rows, H) * W, buffer + H * W, buffer);
+			std::fill_n(buffer + (H - std::min(-rows, H)) * W, std::min(-rows, H) * W, T());
+		}
+		if (!cols) { return; }
+		for (auto* row{ buffer }; row != buffer + H * W; row += W) {
+			if (cols > 0) {
+				std::copy_backward(row, row + W - std::min(cols, W), row + W);
+				std::fill_n(row, std::min(cols, W), T());
+			} else {
+				std::copy(row + std::min(-cols, W), row + W, row);
+				std::fill_n(row + W - std::min(-cols, W), std::min(-cols, W), T());
+			}
+		}
+	}
+	// Rotate a W*H buffer by given rows/cols, wrapping around the edges
+	template <typename T>
+	static void rotateBuffer(T* buffer, const s32 W, const s32 H, const s32 rows, const s32 cols) {
+		if (rows % H) {
+			std::rotate(buffer, buffer + (H - rows % H) % H * W, buffer + H * W);
+		}
+		if (!(cols % W)) { return; }
+		for (auto* row{ buffer }; row != buffer + H * W; row += W)
+			{ std::rotate(row, row + (W - cols % W) % W, row + W); }
+	}
+
 public:
 	~EmuCores() noexcept;
 	explicit EmuCores(
@@ -103,21 +268,50 @@ public:
 		BasicAudioSpec& ref_BAS
 	) noexcept;
 
-	//virtual bool initPlatform() { return false; }
+	// Prepare the host display for this core, again when a parked core is reused
+	virtual void initPlatform() { return; };
 	virtual void processFrame() { return; };
 
 	auto getTotalFrames() const noexcept { return mTotalFrames; }
 	auto getTotalCycles() const noexcept { return mTotalCycles; }
+	auto getIdleFrames()  const noexcept { return mIdleFrames; }
+	auto getIdleCycles()  const noexcept { return mIdleCycles; }
 
 	auto fetchCPF()       const noexcept { return mCyclesPerFrame; }
 	auto fetchFramerate() const noexcept { return mFramerate; }
 
+	void useKeySource(const u8* keys) noexcept { Input.useKeySource(keys); }
+
 	auto changeCPF(const s32 delta) noexcept {
 		const auto newCPF{ std::abs(mCyclesPerFrame) + delta };
 		if (newCPF > 0) { mCyclesPerFrame = newCPF; }
 		return mCyclesPerFrame;
 	}
 
+	// Bytes taken by a save state of this core, 0 if it has none
+	usz  stateSize() const noexcept;
+	bool saveState(std::span<u8> dest) const;
+	bool loadState(std::span<const u8> src);
+
+	// Offsets and sizes of byte ranges within a state
+	using StateRanges = std::vector<std::pair<usz, usz>>;
+
+	// Bring a state saved to dest at given stamp, or 0 if never, up to date
+	// by copying only the pages written since. Returns the stamp to pass the
+	// next time, 0 on failure, and lists the ranges of dest rewritten.
+	u32  saveStateSince(std::span<u8> dest, u32 stamp, StateRanges* ranges = nullptr);
+	// Load a state saved at given stamp, when only pages written since can differ
+	bool loadStateSince(std::span<const u8> src, u32 stamp);
+
+	// Save or load the state file of the running rom through a file mapping
+	bool saveStateFile() const;
+	bool loadStateFile();
+
+	// Run given frames ahead with the current input and show the last, then
+	// restore to the present through given buffer saved at given stamp,
+	// false if it could not
+	bool runAhead(u32 frames, std::span<u8> buffer, u32& stamp);
+
 	bool stateRunning() const noexcept { return (
 		mInterruptType != Interrupt::FINAL &&
 		mInterruptType != Interrupt::ERROR
@@ -206,8 +400,24 @@ public:
 };
 
 class VM_Guest final {
+	static constexpr usz cRewindSeconds{ 60 };
+	static constexpr usz cRewindBytes{ 4 * 1024 * 1024 };
+
+	static constexpr usz cPristineSlots{ 4 };
+
 	std::unique_ptr<EmuCores>
 		mCoreBase{};
+	PristineCache
+		mPristine{ cPristineSlots };
+	RewindBuffer
+		mRewind{};
+
+	static constexpr s32 cRunAheadMax{ 4 };
+
+	u32 mRunAhead{};
+	u32 mAheadStamp{};
+	std::vector<u8>
+		mAheadState{};
 
 public:
 	bool initGameCore(
@@ -232,6 +442,12 @@ public:
 	auto getTotalCycles() const noexcept {
 		return mCoreBase ? mCoreBase->getTotalCycles() : 0;
 	}
+	auto getIdleFrames()  const noexcept {
+		return mCoreBase ? mCoreBase->getIdleFrames() : 0;
+	}
+	auto getIdleCycles()  const noexcept {
+		return mCoreBase ? mCoreBase->getIdleCycles() : 0;
+	}
 	auto fetchCPF()       const noexcept {
 		return mCoreBase ? mCoreBase->fetchCPF() : 0;
 	}
@@ -248,4 +464,40 @@ public:
 			mCoreBase->processFrame();
 		}
 	}
+
+	// Have the core read keys from given snapshot indexed by scancode
+	void useKeySource(const u8* keys) const noexcept {
+		if (mCoreBase) {
+			mCoreBase->useKeySource(keys);
+		}
+	}
+
+	bool saveState() const {
+		return mCoreBase ? mCoreBase->saveStateFile() : false;
+	}
+	bool loadState() {
+		return mCoreBase ? mCoreBase->loadStateFile() : false;
+	}
+
+	void captureRewind() {
+		if (mCoreBase) {
+			mRewind.capture(*mCoreBase);
+		}
+	}
+	bool rewindFrame() {
+		return mCoreBase ? mRewind.rewind(*mCoreBase) : false;
+	}
+	auto getRewindFrames() const noexcept { return mRewind.getFrames(); }
+	auto getRewindBytes()  const noexcept { return mRewind.getBytes(); }
+
+	auto getRunAhead() const noexcept { return mRunAhead; }
+	auto changeRunAhead(const s32 delta) noexcept {
+		if (!mAheadState.empty()) {
+			mRunAhead = std::clamp(static_cast<s32>(mRunAhead) + delta, 0, cRunAheadMax);
+		}
+		return mRunAhead;
+	}
+	bool runAhead() {
+		return mCoreBase && mRunAhead ? mCoreBase->runAhead(mRunAhead, mAheadState, mAheadStamp) : false;
+	}
 };
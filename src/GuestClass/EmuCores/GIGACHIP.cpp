@@ -0,0 +1,628 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <cmath>
+#include <cstring>
+
+#include "GIGACHIP.hpp"
+
+#include "../../HostClass/HomeDirManager.hpp"
+#include "../../HostClass/BasicVideoSpec.hpp"
+#include "../../HostClass/BasicAudioSpec.hpp"
+
+
+
+GIGACHIP::~GIGACHIP() = default;
+GIGACHIP::GIGACHIP(
+	HomeDirManager& ref_HDM,
+	BasicVideoSpec& ref_BVS,
+	BasicAudioSpec& ref_BAS
+) noexcept
+	: EmuCores{ ref_HDM, ref_BVS, ref_BAS }
+{
+	Pages.track(mMemoryBank);
+
+	copyGameToMemory(mMemoryBank.data(), cGameLoadPos);
+	copyFontToMemory(mMemoryBank.data(), 0, 240);
+
+	mProgCounter    = cStartOffset;
+	mFramerate      = cRefreshRate;
+	mCyclesPerFrame = cInstSpeedHi;
+
+	chooseBlend(0);
+
+	initPlatform();
+}
+
+void GIGACHIP::processFrame() {
+	if (isSystemStopped()) { return; }
+	else { ++mTotalFrames; }
+
+	Input.updateKeyStates();
+
+	if (mDelayTimer) { --mDelayTimer; }
+	if (mSoundTimer) { --mSoundTimer; }
+
+	handlePreFrameInterrupt();
+
+	instructionLoop();
+
+	handleEndFrameInterrupt();
+
+	renderAudioData();
+}
+
+void GIGACHIP::saveCoreState(u8* dest) const noexcept {
+	std::memcpy(dest, static_cast<const GIGACHIP_State*>(this), sizeof(GIGACHIP_State));
+}
+
+void GIGACHIP::loadCoreState(const u8* src) {
+	GIGACHIP_State state;
+	std::memcpy(&state, src, sizeof(state));
+	static_cast<GIGACHIP_State&>(*this) = state;
+
+	chooseBlend(mBlendMode);
+	BVS.setTextureAlpha(mOpacity);
+
+	// returning from running ahead leaves the frame ahead on screen
+	if (mRunningAhead) { return; }
+
+	std::copy_n(
+		mForegroundBuffer.data(),
+		mDisplaySize, BVS.lockTexture()
+	);
+	BVS.unlockTexture();
+}
+
+void GIGACHIP::handlePreFrameInterrupt() noexcept {
+	switch (mInterruptType)
+	{
+		case Interrupt::FRAME:
+			mInterruptType  = Interrupt::CLEAR;
+			mCyclesPerFrame = std::abs(mCyclesPerFrame);
+			return;
+
+		case Interrupt::SOUND:
+			if (!mSoundTimer) {
+				mInterruptType = Interrupt::FINAL;
+				mCyclesPerFrame = 0;
+			}
+			return;
+	}
+}
+
+void GIGACHIP::handleEndFrameInterrupt() noexcept {
+	switch (mInterruptType)
+	{
+		case Interrupt::INPUT:
+			if (Input.keyPressed(mRegisterV[mInputReg], mTotalFrames)) {
+				mInterruptType  = Interrupt::CLEAR;
+				mCyclesPerFrame = std::abs(mCyclesPerFrame);
+				mAudioTone      = calcAudioTone();
+				mSoundTimer     = 2;
+			}
+			return;
+
+		case Interrupt::ERROR:
+		case Interrupt::FINAL:
+			mCyclesPerFrame = 0;
+			return;
+	}
+}
+
+constexpr GIGACHIP::Opcode GIGACHIP::classifyOpcode(const u32 HI, const u32 LO) noexcept {
+	using enum Opcode;
+	switch (HI >> 4) {
+		case 0x0:
+			switch (HI) {
+				case 0x00: break;
+				case 0x01: return _01NN;
+				case 0x02: return _02NN;
+				case 0x03: return _03NN;
+				case 0x04: return _04NN;
+				case 0x05: return _05NN;
+				case 0x06: return LO & 0xF0 ? ERROR_OPCODE : _060N;
+				case 0x07: return LO        ? ERROR_OPCODE : _0700;
+				case 0x08: return LO & 0xF0 ? ERROR_OPCODE : _080N;
+				case 0x09: return _09NN;
+				default:   return ERROR_00NN;
+			}
+			switch (LO & 0xF0) {
+				case 0xB0: return _00BN;
+				case 0xC0: return _00CN;
+			}
+			switch (LO) {
+				case 0x10: return _0010;
+				case 0x11: return _0011;
+				case 0xE0: return _00E0;
+				case 0xEE: return _00EE;
+				case 0xFB: return _00FB;
+				case 0xFC: return _00FC;
+				case 0xFD: return _00FD;
+				case 0xFE: return _00FE;
+				case 0xFF: return _00FF;
+				default:   return ERROR_00NN;
+			}
+		case 0x1: return _1NNN;
+		case 0x2: return _2NNN;
+		case 0x3: return _3xNN;
+		case 0x4: return _4xNN;
+		case 0x5: return LO & 0xF ? ERROR_OPCODE : _5xy0;
+		case 0x6: return _6xNN;
+		case 0x7: return _7xNN;
+		case 0x8:
+			switch (LO & 0xF) {
+				case 0x0: return _8xy0;
+				case 0x1: return _8xy1;
+				case 0x2: return _8xy2;
+				case 0x3: return _8xy3;
+				case 0x4: return _8xy4;
+				case 0x5: return _8xy5;
+				case 0x7: return _8xy7;
+				case 0x6: return _8xy6;
+				case 0xE: return _8xyE;
+				default:  return ERROR_OPCODE;
+			}
+		case 0x9: return LO & 0xF ? ERROR_OPCODE : _9xy0;
+		case 0xA: return _ANNN;
+		case 0xB: return _BXNN;
+		case 0xC: return _CxNN;
+		case 0xD: return _DxyN;
+		case 0xE:
+			switch (LO) {
+				case 0x9E: return _Ex9E;
+				case 0xA1: return _ExA1;
+				default:   return ERROR_OPCODE;
+			}
+		default:
+			switch (LO) {
+				case 0x07: return _Fx07;
+				case 0x0A: return _Fx0A;
+				case 0x15: return _Fx15;
+				case 0x18: return _Fx18;
+				case 0x1E: return _Fx1E;
+				case 0x29: return _Fx29;
+				case 0x30: return _Fx30;
+				case 0x33: return _Fx33;
+				case 0x55: return _Fx55;
+				case 0x65: return _Fx65;
+				case 0x75: return _Fx75;
+				case 0x85: return _Fx85;
+				default:   return ERROR_OPCODE;
+			}
+	}
+}
+
+const std::array<GIGACHIP::Opcode, 0x10000>
+	GIGACHIP::cOpcodeTable{ makeOpcodeTable<Opcode>(classifyOpcode) };
+
+void GIGACHIP::instructionLoop() {
+
+	auto cycleCount{ 0 };
+	for (; cycleCount < mCyclesPerFrame; ++cycleCount) {
+		const auto HI{ readMemory(mProgCounter++) };
+		const auto LO{ readMemory(mProgCounter++) };
+
+		using enum Opcode;
+		switch (cOpcodeTable[HI << 8 | LO]) {
+			case _0010: instruction_0010();                         break;
+			case _0011: instruction_0011();                         break;
+			case _00BN: instruction_00BN(LO & 0xF);                 break;
+			case _00CN: instruction_00CN(LO & 0xF);                 break;
+			case _00E0: instruction_00E0();                         break;
+			case _00EE: instruction_00EE();                         break;
+			case _00FB: instruction_00FB();                         break;
+			case _00FC: instruction_00FC();                         break;
+			case _00FD: instruction_00FD();                         break;
+			case _00FE:
+			case _00FF:
+				// resolution is fixed in mega mode
+				break;
+			case _01NN: instruction_01NN(LO);                       break;
+			case _02NN: instruction_02NN(LO);                       break;
+			case _03NN: instruction_03NN(LO);                       break;
+			case _04NN: instruction_04NN(LO);                       break;
+			case _05NN: instruction_05NN(LO);                       break;
+			case _060N: instruction_060N(LO & 0xF);                 break;
+			case _0700: instruction_0700();                         break;
+			case _080N: instruction_080N(LO & 0xF);                 break;
+			case _09NN: instruction_09NN(LO);                       break;
+			case _1NNN: instruction_1NNN((HI << 8 | LO) & 0xFFF);   break;
+			case _2NNN: instruction_2NNN((HI << 8 | LO) & 0xFFF);   break;
+			case _3xNN: instruction_3xNN(HI & 0xF, LO);             break;
+			case _4xNN: instruction_4xNN(HI & 0xF, LO);             break;
+			case _5xy0: instruction_5xy0(HI & 0xF, LO >> 4);        break;
+			case _6xNN: instruction_6xNN(HI & 0xF, LO);             break;
+			case _7xNN: instruction_7xNN(HI & 0xF, LO);             break;
+			case _8xy0: instruction_8xy0(HI & 0xF, LO >> 4);        break;
+			case _8xy1: instruction_8xy1(HI & 0xF, LO >> 4);        break;
+			case _8xy2: instruction_8xy2(HI & 0xF, LO >> 4);        break;
+			case _8xy3: instruction_8xy3(HI & 0xF, LO >> 4);        break;
+			case _8xy4: instruction_8xy4(HI & 0xF, LO >> 4);        break;
+			case _8xy5: instruction_8xy5(HI & 0xF, LO >> 4);        break;
+			case _8xy7: instruction_8xy7(HI & 0xF, LO >> 4);        break;
+			case _8xy6: instruction_8xy6(HI & 0xF, LO >> 4);        break;
+			case _8xyE: instruction_8xyE(HI & 0xF, LO >> 4);        break;
+			case _9xy0: instruction_9xy0(HI & 0xF, LO >> 4);        break;
+			case _ANNN: instruction_ANNN((HI << 8 | LO) & 0xFFF);   break;
+			case _BXNN: instruction_BXNN(HI & 0xF, (HI << 8 | LO) & 0xFFF); break;
+			case _CxNN: instruction_CxNN(HI & 0xF, LO);             break;
+			case _DxyN: instruction_DxyN(HI & 0xF, LO >> 4, LO & 0xF); break;
+			case _Ex9E: instruction_Ex9E(HI & 0xF);                 break;
+			case _ExA1: instruction_ExA1(HI & 0xF);                 break;
+			case _Fx07: instruction_Fx07(HI & 0xF);                 break;
+			case _Fx0A: instruction_Fx0A(HI & 0xF);                 break;
+			case _Fx15: instruction_Fx15(HI & 0xF);                 break;
+			case _Fx18: instruction_Fx18(HI & 0xF);                 break;
+			case _Fx1E: instruction_Fx1E(HI & 0xF);                 break;
+			case _Fx29: instruction_Fx29(HI & 0xF);                 break;
+			case _Fx30: instruction_Fx30(HI & 0xF);                 break;
+			case _Fx33: instruction_Fx33(HI & 0xF);                 break;
+			case _Fx55: instruction_Fx55(HI & 0xF);                 break;
+			case _Fx65: instruction_Fx65(HI & 0xF);                 break;
+			case _Fx75: instruction_Fx75(HI & 0xF);                 break;
+			case _Fx85: instruction_Fx85(HI & 0xF);                 break;
+			[[unlikely]]
+			case ERROR_00NN: instructionErrorML(HI, LO);            break;
+			[[unlikely]]
+			default:         instructionError(HI, LO);              break;
+		}
+	}
+	mTotalCycles += cycleCount;
+}
+
+void GIGACHIP::jumpProgramTo(const s32 next) noexcept {
+	if (mProgCounter - 2 == next) [[unlikely]] {
+		setInterrupt(Interrupt::SOUND);
+	} else { mProgCounter = static_cast<u16>(next); }
+}
+
+f32  GIGACHIP::calcAudioTone() const {
+	return (160.0f + 8.0f * (
+		(mProgCounter >> 1) + mStackBank[mStackTop] + 1 & 0x3E)
+	) / BAS.getFrequency();
+}
+
+void GIGACHIP::renderAudioData() {
+	std::vector<s16> audioBuffer(static_cast<usz>(BAS.getFrequency() / cRefreshRate));
+
+	if (mSoundTimer) {
+		const auto amplitute{ BAS.getAmplitude() };
+		for (auto& sample_s16 : audioBuffer) {
+			sample_s16 = mWavePhase > 0.5f ? amplitute : -amplitute;
+			mWavePhase = std::fmod(mWavePhase + mAudioTone, 1.0f);
+		}
+		BVS.setFrameColor(cBitsColor[0], cBitsColor[1]);
+	} else if (mTrack.mTrackLen) {
+		const auto volume{ BAS.getVolume() };
+		for (auto& sample_s16 : audioBuffer) {
+			sample_s16 = static_cast<s16>((readMemory(
+				mTrack.mMemPoint + static_cast<u32>(mTrack.mTrackPos)
+			) - 128) * volume);
+
+			if ((mTrack.mTrackPos += mTrack.mStepping) >= std::abs(mTrack.mTrackLen)) {
+				if (mTrack.mTrackLen < 0) {
+					mTrack.mTrackPos += mTrack.mTrackLen;
+				} else {
+					resetAudioTrack();
+					break;
+				}
+			}
+		}
+		BVS.setFrameColor(0xFF202020, 0xFF202020);
+	} else {
+		mWavePhase = 0.0f;
+		BVS.setFrameColor(cBitsColor[0], cBitsColor[0]);
+	}
+	if (!mRunningAhead) {
+		BAS.pushAudioData(audioBuffer.data(), audioBuffer.size());
+	}
+}
+
+void GIGACHIP::resetAudioTrack() noexcept {
+	mTrack = {};
+}
+
+void GIGACHIP::startAudioTrack(const bool repeat) noexcept {
+	mTrack.mTrackLen = readMemoryI(2) << 16
+					 | readMemoryI(3) <<  8
+					 | readMemoryI(4);
+
+	if (!mTrack.mTrackLen) {
+		resetAudioTrack();
+		return;
+	}
+
+	mTrack.mStepping = (readMemoryI(0) << 8 | readMemoryI(1)) * 1.0 / BAS.getFrequency();
+	mTrack.mTrackLen = repeat ? -mTrack.mTrackLen : mTrack.mTrackLen;
+	mTrack.mTrackPos = 0.0;
+	mTrack.mMemPoint = mRegisterI + 6;
+}
+
+void GIGACHIP::setDisplayOpacity(const s32 alpha) {
+	mOpacity = static_cast<u8>(alpha);
+	BVS.setTextureAlpha(mOpacity);
+}
+
+void GIGACHIP::flushBuffers(const FlushType option) {
+	switch (option) {
+		case FlushType::DISCARD:
+			mColorPalette.fill(0);
+			mBackgroundBuffer.fill(0);
+			mCollisionMap.fill(0);
+			break;
+
+		case FlushType::DISPLAY:
+			mForegroundBuffer = mBackgroundBuffer;
+			mBackgroundBuffer.fill(0);
+			mCollisionMap.fill(0);
+			std::copy_n(
+				mForegroundBuffer.data(),
+				mDisplaySize, BVS.lockTexture()
+			);
+			BVS.unlockTexture();
+			break;
+	}
+}
+
+namespace {
+	constexpr f32 minF{ 1.0f / 255.0f };
+
+	enum ColorMod {
+		RGB, BRG, GBR,
+		RBG, GRB, BGR,
+		GRAY, SEPIA,
+	};
+
+	u32 blendPixel(
+		u32 srcPixel, const u32 dstPixel, const u8 rgbmod,
+		const f32 alpha, const bool inverted,
+		f32(*blend)(const f32, const f32) noexcept
+	) noexcept {
+		const auto srcA{ (srcPixel >> 24) * alpha * minF };
+		if (srcA < minF) [[unlikely]] { return dstPixel; }
+		if (inverted) { srcPixel ^= 0x00FFFFFF; }
+
+		auto srcR{ (srcPixel >> 16 & 0xFF) * minF };
+		auto srcG{ (srcPixel >>  8 & 0xFF) * minF };
+		auto srcB{ (srcPixel       & 0xFF) * minF };
+
+		const auto dstA{ (dstPixel >> 24       ) * minF };
+		const auto dstR{ (dstPixel >> 16 & 0xFF) * minF };
+		const auto dstG{ (dstPixel >>  8 & 0xFF) * minF };
+		const auto dstB{ (dstPixel       & 0xFF) * minF };
+
+		switch (rgbmod) {
+			case BRG:
+				std::swap(srcR, srcG);
+				std::swap(srcR, srcB);
+				break;
+			case GBR:
+				std::swap(srcR, srcG);
+				std::swap(srcG, srcB);
+				break;
+			case RBG:
+				std::swap(srcG, srcB);
+				break;
+			case GRB:
+				std::swap(srcR, srcG);
+				break;
+			case BGR:
+				std::swap(srcR, srcB);
+				break;
+			case GRAY:
+				srcR = srcG = srcB =
+					srcR * 0.299f + srcG * 0.587f + srcB * 0.114f;
+				break;
+			case SEPIA: {
+				const f32 R{ srcR * 0.393f + srcG * 0.769f + srcB * 0.198f },
+						  G{ srcR * 0.349f + srcG * 0.686f + srcB * 0.168f },
+						  B{ srcR * 0.272f + srcG * 0.534f + srcB * 0.131f };
+				srcR = std::min(R, 1.0f);
+				srcG = std::min(G, 1.0f);
+				srcB = std::min(B, 1.0f);
+			} break;
+		}
+
+		if (!blend) {
+			return static_cast<u8>(std::roundf(srcA * 255.0f)) << 24
+				 | static_cast<u8>(std::roundf(srcR * 255.0f)) << 16
+				 | static_cast<u8>(std::roundf(srcG * 255.0f)) <<  8
+				 | static_cast<u8>(std::roundf(srcB * 255.0f));
+		}
+
+		auto A{ 1.0f };
+		auto R{ blend(srcR, dstR) };
+		auto G{ blend(srcG, dstG) };
+		auto B{ blend(srcB, dstB) };
+
+		if (srcA < 1.0f) {
+			A = (1.0f - srcA) * dstA + srcA;
+			R = (1.0f - srcA) * dstR + srcA * R;
+			G = (1.0f - srcA) * dstG + srcA * G;
+			B = (1.0f - srcA) * dstB + srcA * B;
+		}
+
+		return static_cast<u8>(std::roundf(A * 255.0f)) << 24
+			 | static_cast<u8>(std::roundf(R * 255.0f)) << 16
+			 | static_cast<u8>(std::roundf(G * 255.0f)) <<  8
+			 | static_cast<u8>(std::roundf(B * 255.0f));
+	}
+}
+
+void GIGACHIP::chooseBlend(const s32 N) noexcept {
+	mBlendMode = static_cast<u8>(N);
+	switch (N) {
+		case 0x0: // normal
+			mBlendAlgo = [](const f32 src, const f32) noexcept {
+				return src;
+			};
+			return;
+
+		/*------------------------ LIGHTENING MODES ------------------------*/
+
+		case 0x1: // lighten only
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return std::max(src, dst);
+			};
+			return;
+
+		case 0x2: // screen
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return 1.0f - (1.0f - src) * (1.0f - dst);
+			};
+			return;
+
+		case 0x3: // color dodge
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return std::min(dst / (1.0f - src), 1.0f);
+			};
+			return;
+
+		case 0x4: // linear dodge
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return std::min(src + dst, 1.0f);
+			};
+			return;
+
+		/*------------------------ DARKENING MODES -------------------------*/
+
+		case 0x5: // darken only
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return std::min(src, dst);
+			};
+			return;
+
+		case 0x6: // multiply
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return src * dst;
+			};
+			return;
+
+		case 0x7: // color burn
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				if (!src) { return 0.0f; } // handle divide-by-zero
+				return std::max(1.0f - (1.0f - dst) / src, 0.0f);
+			};
+			return;
+
+		case 0x8: // linear burn
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return std::max(src + dst - 1.0f, 0.0f);
+			};
+			return;
+
+		/*-------------------------- OTHER MODES ---------------------------*/
+
+		case 0x9: // average
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return (src + dst) / 2.0f;
+			};
+			return;
+
+		case 0xA: // difference
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return std::abs(src - dst);
+			};
+			return;
+
+		case 0xB: // negation
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return 1.0f - std::abs(1.0f - src - dst);
+			};
+			return;
+
+		case 0xC: // overlay
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				if (src < 0.5f) { return 2.0f * dst * src; }
+				return 1.0f - 2.0f * (1.0f - dst) * (1.0f - src);
+			};
+			return;
+
+		case 0xD: // reflect
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				if (src == 1.0f) { return 1.0f; } // handle divide-by-zero
+				return std::min(dst * dst / (1.0f - src), 1.0f);
+			};
+			return;
+
+		case 0xE: // glow
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				if (dst == 1.0f) { return 1.0f; } // handle divide-by-zero
+				return std::min(src * src / (1.0f - dst), 1.0f);
+			};
+			return;
+
+		case 0xF: // overwrite
+			mBlendAlgo = nullptr;
+			return;
+	}
+}
+
+void GIGACHIP::drawSprite(const s32 X, const s32 Y, const s32 N) {
+	const s32 VX{ mRegisterV[X] };
+	const s32 VY{ mRegisterV[Y] };
+
+	mRegisterV[0xF] = 0;
+
+	const auto currW{ Texture.W }; auto tempW{ currW };
+	const auto currH{ Texture.H }; auto tempH{ currH };
+
+	auto flipX{ Texture.flip_X };
+	auto flipY{ Texture.flip_Y };
+
+	Texture.alpha = (N ^ 0xF) / 15.0f;
+
+	if (Texture.uneven) {
+		std::swap(tempW, tempH);
+		std::swap(flipX, flipY);
+	}
+
+	auto memY{ 0 }, memX{ 0 }; // position vars for RAM access
+
+	for (auto H{ 0 }, pY{ VY % mDisplayH }; H < tempH; ++H, ++pY %= mDisplayH) {
+		for (auto W{ 0 }, pX{ VX }; W < tempW; ++W, ++pX &= mDisplayWb) {
+
+			if (Texture.rotate) {
+				memX = H; memY = tempW - W - 1;
+			} else {
+				memX = W; memY = H;
+			}
+
+			if (flipX) { memX = currW - memX - 1; }
+			if (flipY) { memY = currH - memY - 1; }
+
+			if (const auto sourceColorIdx{ readMemoryI(memY * currW + memX) }; sourceColorIdx)
+			{
+				auto& collideCoord{ mCollisionMap[pY * mDisplayW + pX] };
+				auto& backbufCoord{ mBackgroundBuffer[pY * mDisplayW + pX] };
+
+				if (collideCoord == Texture.collision)
+					[[unlikely]] { mRegisterV[0xF] = 1; }
+
+				collideCoord = sourceColorIdx;
+				if (!Texture.nodraw) {
+					backbufCoord = blendPixel(
+						mColorPalette[sourceColorIdx],
+						backbufCoord, Texture.rgbmod,
+						Texture.alpha, Texture.invert,
+						mBlendAlgo
+					);
+				}
+			}
+			if (!Quirk.wrapSprite && pX == mDisplayWb) { break; }
+		}
+		if (!Quirk.wrapSprite && pY == mDisplayHb) { break; }
+	}
+}
+
+void GIGACHIP::initPlatform() {
+	isManualRefresh(true);
+	setDisplayResolution(256, 192);
+	BVS.setBackColor(0);
+	BVS.createTexture(mDisplayW, mDisplayH);
+	BVS.setAspectRatio(512, 384, -2);
+}
@@ -0,0 +1,592 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include "EmuCores.hpp"
+
+// Machine state of GIGACHIP but for its memory, which is saved by pages
+// instead. Trivially copyable, the core inherits it like CHIP8_MODERN.
+struct GIGACHIP_State {
+	u8  mRegisterV[16]{};
+	u16 mStackBank[16]{};
+
+	f32  mWavePhase{};
+	f32  mAudioTone{};
+
+	u8  mDelayTimer{};
+	u8  mSoundTimer{};
+
+	u16 mProgCounter{};
+
+	u8  mInputReg{};
+	u8  mStackTop{};
+	u8  mOpacity{ 0xFF };
+	u8  mBlendMode{};
+	u32 mRegisterI{};
+
+	struct AudioTrack final {
+		u32  mMemPoint{};
+		s32  mTrackLen{}; // negative if the track repeats
+		f64  mStepping{};
+		f64  mTrackPos{};
+	} mTrack;
+
+	struct TextureTraits final {
+		s32 W{}, H{};
+		u8   collision{ 0xFF };
+		u8   rgbmod{};
+		bool rotate{};
+		bool flip_X{};
+		bool flip_Y{};
+		bool invert{};
+		bool nodraw{};
+		bool uneven{};
+		f32  alpha{ 1.0f };
+	} Texture;
+
+	std::array<u32, 256>
+		mColorPalette{};
+
+	std::array<u32, 256 * 192>
+		mForegroundBuffer{};
+	std::array<u32, 256 * 192>
+		mBackgroundBuffer{};
+	std::array<u8,  256 * 192>
+		mCollisionMap{};
+};
+
+class GIGACHIP final : public EmuCores, private GIGACHIP_State {
+	static constexpr u32 cTotalMemory{ 0x1000000u };
+	static constexpr u32 cGameLoadPos{ 0x0200u };
+	static constexpr u32 cStartOffset{ 0x0200u };
+	static constexpr f32 cRefreshRate{ 60.000f };
+	static constexpr s32 cInstSpeedHi{  10'000 };
+
+public:
+	static constexpr bool testGameSize(const usz size) noexcept {
+		return size + cGameLoadPos <= cTotalMemory;
+	}
+
+public:
+	explicit GIGACHIP(
+		HomeDirManager&,
+		BasicVideoSpec&,
+		BasicAudioSpec&
+	) noexcept;
+	~GIGACHIP() noexcept;
+
+	void processFrame() override;
+
+private:
+	static_assert(std::is_trivially_copyable_v<GIGACHIP_State>);
+
+	usz  coreStateSize() const noexcept override { return sizeof(GIGACHIP_State); }
+	void saveCoreState(u8* dest) const noexcept override;
+	void loadCoreState(const u8* src) override;
+
+	std::array<u8, cTotalMemory>
+		mMemoryBank{};
+
+	void setTextureFlags(const s32 bits) noexcept {
+		Texture.rotate = bits >> 0 & 0x1; // false: as-is | true: 90° clockwise
+		Texture.flip_X = bits >> 1 & 0x1; // flip on the X axis (rotation agnostic)
+		Texture.flip_Y = bits >> 2 & 0x1; // flip on the Y axis (rotation agnostic)
+		Texture.invert = bits >> 3 & 0x1; // invert RGB channels
+		Texture.rgbmod = bits >> 4 & 0x7; // RGB channel swaps | sepia/grayscale
+		Texture.nodraw = bits >> 7 & 0x1; // disable drawing, palette index only
+		Texture.uneven = Texture.rotate && (Texture.W != Texture.H);
+	}
+
+	using BlendAlgo = f32(*)(const f32 src, const f32 dst) noexcept;
+	BlendAlgo mBlendAlgo{}; // null when overwriting
+
+	// Write memory at given index using given value
+	void writeMemory(const u32 value, const u32 pos) noexcept {
+		const auto index{ pos & mMemoryBank.size() - 1 };
+		mMemoryBank[index] = static_cast<u8>(value);
+		Pages.touch(index);
+	}
+	// Write memory at saved index using given value
+	void writeMemoryI(const u32 value, const u32 pos) noexcept {
+		const auto index{ mRegisterI + pos & mMemoryBank.size() - 1 };
+		mMemoryBank[index] = static_cast<u8>(value);
+		Pages.touch(index);
+	}
+
+	// Read memory at given index
+	auto readMemory(const u32 pos) const noexcept {
+		return mMemoryBank[pos & mMemoryBank.size() - 1];
+	}
+	// Read memory at saved index
+	auto readMemoryI(const u32 pos) const noexcept {
+		return mMemoryBank[mRegisterI + pos & mMemoryBank.size() - 1];
+	}
+	// Read memory at saved index
+	auto readMemoryI() const noexcept {
+		return mMemoryBank[mRegisterI & mMemoryBank.size() - 1];
+	}
+
+	enum class Opcode : u8 {
+		ERROR_00NN, ERROR_OPCODE,
+		_0010, _0011, _00BN, _00CN, _00E0, _00EE, _00FB, _00FC, _00FD, _00FE, _00FF,
+		_01NN, _02NN, _03NN, _04NN, _05NN, _060N, _0700, _080N, _09NN,
+		_1NNN, _2NNN, _3xNN, _4xNN, _5xy0, _6xNN, _7xNN,
+		_8xy0, _8xy1, _8xy2, _8xy3, _8xy4, _8xy5, _8xy7, _8xy6, _8xyE,
+		_9xy0, _ANNN, _BXNN, _CxNN, _DxyN, _Ex9E, _ExA1,
+		_Fx07, _Fx0A, _Fx15, _Fx18, _Fx1E, _Fx29, _Fx30, _Fx33,
+		_Fx55, _Fx65, _Fx75, _Fx85,
+	};
+
+	static constexpr Opcode classifyOpcode(const u32 HI, const u32 LO) noexcept;
+
+	// Handler of every opcode, malformed encodings map to the error handlers
+	static const std::array<Opcode, 0x10000> cOpcodeTable;
+
+private:
+	void initPlatform() override;
+
+	void renderAudioData();
+	void renderVideoData();
+
+	void instructionLoop();
+
+	void handlePreFrameInterrupt() noexcept;
+	void handleEndFrameInterrupt() noexcept;
+
+	f32  calcAudioTone() const;
+	void jumpProgramTo(s32) noexcept;
+
+	void flushBuffers(const FlushType);
+	void setDisplayOpacity(const s32 alpha);
+	void chooseBlend(const s32 N) noexcept;
+
+	void resetAudioTrack() noexcept;
+	void startAudioTrack(const bool repeat) noexcept;
+
+	void drawSprite(const s32 X, const s32 Y, const s32 N);
+
+	// Skip next instruction, 01NN NNNN counts as one
+	void skipInstruction() noexcept {
+		mProgCounter += readMemory(mProgCounter) == 0x01 ? 4 : 2;
+	}
+
+	void scrollDisplay(const s32 rows, const s32 cols) noexcept {
+		rotateBuffer(mForegroundBuffer.data(), mDisplayW, mDisplayH, rows, cols);
+	}
+
+/*==================================================================*/
+	#pragma region 0 instruction branch
+/*==================================================================*/
+
+	// 00BN - scroll display N lines up
+	void instruction_00BN(const s32 N) {
+		if (Quirk.waitScroll) [[unlikely]]
+			{ setInterrupt(Interrupt::FRAME); }
+		scrollDisplay(-N, 0);
+	}
+	// 00CN - scroll display N lines down
+	void instruction_00CN(const s32 N) {
+		if (Quirk.waitScroll) [[unlikely]]
+			{ setInterrupt(Interrupt::FRAME); }
+		scrollDisplay(+N, 0);
+	}
+	// 00E0 - push (and then clear) framebuffer to screen
+	void instruction_00E0() {
+		setInterrupt(Interrupt::FRAME);
+		flushBuffers(FlushType::DISPLAY);
+	}
+	// 00EE - return from subroutine
+	void instruction_00EE() {
+		mProgCounter = mStackBank[--mStackTop & 0xF];
+	}
+	// 00FB - scroll display 4 pixels right
+	void instruction_00FB() {
+		if (Quirk.waitScroll) [[unlikely]]
+			{ setInterrupt(Interrupt::FRAME); }
+		scrollDisplay(0, +4);
+	}
+	// 00FC - scroll display 4 pixels left
+	void instruction_00FC() {
+		if (Quirk.waitScroll) [[unlikely]]
+			{ setInterrupt(Interrupt::FRAME); }
+		scrollDisplay(0, -4);
+	}
+	// 00FD - stop signal
+	void instruction_00FD() {
+		setInterrupt(Interrupt::SOUND);
+	}
+
+	// 0010 - reset display, mega mode cannot be left
+	void instruction_0010() {
+		setInterrupt(Interrupt::FRAME);
+		resetAudioTrack();
+		flushBuffers(FlushType::DISCARD);
+	}
+	// 0011 - reset display, mega mode is always on
+	void instruction_0011() {
+		setInterrupt(Interrupt::FRAME);
+		resetAudioTrack();
+		flushBuffers(FlushType::DISCARD);
+	}
+	// 01NN - set I to NN'NNNN
+	void instruction_01NN(const s32 NN) {
+		mRegisterI = NN << 16 | readMemory(mProgCounter) << 8 | readMemory(mProgCounter + 1);
+		mProgCounter += 2;
+	}
+	// 02NN - load NN palette colors from RAM at I
+	void instruction_02NN(const s32 NN) {
+		auto offset{ mRegisterI };
+		for (auto pos{ 0 }; pos < NN; offset += 4) {
+			mColorPalette[++pos]
+				= readMemory(offset + 0) << 24
+				| readMemory(offset + 1) << 16
+				| readMemory(offset + 2) <<  8
+				| readMemory(offset + 3);
+		}
+	}
+	// 03NN - set sprite width to NN
+	void instruction_03NN(const s32 NN) {
+		Texture.W = NN ? NN : 256;
+	}
+	// 04NN - set sprite height to NN
+	void instruction_04NN(const s32 NN) {
+		Texture.H = NN ? NN : 256;
+	}
+	// 05NN - set screen brightness to NN
+	void instruction_05NN(const s32 NN) {
+		setDisplayOpacity(NN);
+	}
+	// 060N - start digital sound from RAM at I, repeat if N == 0
+	void instruction_060N(const s32 N) {
+		startAudioTrack(N == 0);
+	}
+	// 0700 - stop digital sound
+	void instruction_0700() {
+		resetAudioTrack();
+	}
+	// 080N - set trait flags to VF, blend mode to N
+	void instruction_080N(const s32 N) {
+		setTextureFlags(mRegisterV[0xF]);
+		chooseBlend(N);
+	}
+	// 09NN - set collision color to palette entry NN
+	void instruction_09NN(const s32 NN) {
+		Texture.collision = static_cast<u8>(NN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 1 instruction branch
+/*==================================================================*/
+
+	// 1NNN - jump to NNN
+	void instruction_1NNN(const s32 NNN) {
+		jumpProgramTo(NNN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 2 instruction branch
+/*==================================================================*/
+
+	// 2NNN - call subroutine at NNN
+	void instruction_2NNN(const s32 NNN) {
+		mStackBank[mStackTop++ & 0xF] = mProgCounter;
+		jumpProgramTo(NNN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 3 instruction branch
+/*==================================================================*/
+
+	// 3XNN - skip next instruction if VX == NN
+	void instruction_3xNN(const s32 X, const s32 NN) {
+		if (mRegisterV[X] == NN) { skipInstruction(); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 4 instruction branch
+/*==================================================================*/
+
+	// 4XNN - skip next instruction if VX != NN
+	void instruction_4xNN(const s32 X, const s32 NN) {
+		if (mRegisterV[X] != NN) { skipInstruction(); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 5 instruction branch
+/*==================================================================*/
+
+	// 5XY0 - skip next instruction if VX == VY
+	void instruction_5xy0(const s32 X, const s32 Y) {
+		if (mRegisterV[X] == mRegisterV[Y]) { skipInstruction(); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 6 instruction branch
+/*==================================================================*/
+
+	// 6XNN - set VX = NN
+	void instruction_6xNN(const s32 X, const s32 NN) {
+		mRegisterV[X] = static_cast<u8>(NN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 7 instruction branch
+/*==================================================================*/
+
+	// 7XNN - set VX = VX + NN
+	void instruction_7xNN(const s32 X, const s32 NN) {
+		mRegisterV[X] += static_cast<u8>(NN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 8 instruction branch
+/*==================================================================*/
+
+	// 8XY0 - set VX = VY
+	void instruction_8xy0(const s32 X, const s32 Y) {
+		mRegisterV[X] = mRegisterV[Y];
+	}
+	// 8XY1 - set VX = VX | VY
+	void instruction_8xy1(const s32 X, const s32 Y) {
+		mRegisterV[X] |= mRegisterV[Y];
+		if (Quirk.clearVF) { mRegisterV[0xF] = 0; }
+	}
+	// 8XY2 - set VX = VX & VY
+	void instruction_8xy2(const s32 X, const s32 Y) {
+		mRegisterV[X] &= mRegisterV[Y];
+		if (Quirk.clearVF) { mRegisterV[0xF] = 0; }
+	}
+	// 8XY3 - set VX = VX ^ VY
+	void instruction_8xy3(const s32 X, const s32 Y) {
+		mRegisterV[X] ^= mRegisterV[Y];
+		if (Quirk.clearVF) { mRegisterV[0xF] = 0; }
+	}
+	// 8XY4 - set VX = VX + VY, VF = carry
+	void instruction_8xy4(const s32 X, const s32 Y) {
+		const auto sum{ mRegisterV[X] + mRegisterV[Y] };
+		mRegisterV[X]   = static_cast<u8>(sum);
+		mRegisterV[0xF] = static_cast<u8>(sum >> 8);
+	}
+	// 8XY5 - set VX = VX - VY, VF = !borrow
+	void instruction_8xy5(const s32 X, const s32 Y) {
+		const bool nborrow{ mRegisterV[X] >= mRegisterV[Y] };
+		mRegisterV[X]   = mRegisterV[X] - mRegisterV[Y];
+		mRegisterV[0xF] = nborrow;
+	}
+	// 8XY7 - set VX = VY - VX, VF = !borrow
+	void instruction_8xy7(const s32 X, const s32 Y) {
+		const bool nborrow{ mRegisterV[Y] >= mRegisterV[X] };
+		mRegisterV[X]   = mRegisterV[Y] - mRegisterV[X];
+		mRegisterV[0xF] = nborrow;
+	}
+	// 8XY6 - set VX = VY >> 1, VF = carry
+	void instruction_8xy6(const s32 X, const s32 Y) {
+		if (!Quirk.shiftVX) { mRegisterV[X] = mRegisterV[Y]; }
+		const bool lsb{ (mRegisterV[X] & 1) == 1 };
+		mRegisterV[X]   = mRegisterV[X] >> 1;
+		mRegisterV[0xF] = lsb;
+	}
+	// 8XYE - set VX = VY << 1, VF = carry
+	void instruction_8xyE(const s32 X, const s32 Y) {
+		if (!Quirk.shiftVX) { mRegisterV[X] = mRegisterV[Y]; }
+		const bool msb{ (mRegisterV[X] >> 7) == 1 };
+		mRegisterV[X]   = mRegisterV[X] << 1;
+		mRegisterV[0xF] = msb;
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region 9 instruction branch
+/*==================================================================*/
+
+	// 9XY0 - skip next instruction if VX != VY
+	void instruction_9xy0(const s32 X, const s32 Y) {
+		if (mRegisterV[X] != mRegisterV[Y]) { skipInstruction(); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region A instruction branch
+/*==================================================================*/
+
+	// ANNN - set I = NNN
+	void instruction_ANNN(const s32 NNN) {
+		mRegisterI = NNN;
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region B instruction branch
+/*==================================================================*/
+
+	// BXNN - jump to NNN + V0 (else VX)
+	void instruction_BXNN(const s32 X, const s32 NNN) {
+		jumpProgramTo(NNN + mRegisterV[Quirk.jmpRegX ? X : 0]);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region C instruction branch
+/*==================================================================*/
+
+	// CXNN - set VX = rnd(256) & NN
+	void instruction_CxNN(const s32 X, const s32 NN) {
+		mRegisterV[X] = static_cast<u8>(Wrand.get() & NN);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region D instruction branch
+/*==================================================================*/
+
+	// DXYN - draw texture at VX and VY with opacity N ^ 0xF
+	void instruction_DxyN(const s32 X, const s32 Y, const s32 N) {
+		drawSprite(X, Y, N);
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region E instruction branch
+/*==================================================================*/
+
+	// EX9E - skip next instruction if key VX down (p1)
+	void instruction_Ex9E(const s32 X) {
+		if ( Input.keyHeld_P1(mRegisterV[X])) { skipInstruction(); }
+	}
+	// EXA1 - skip next instruction if key VX up (p1)
+	void instruction_ExA1(const s32 X) {
+		if (!Input.keyHeld_P1(mRegisterV[X])) { skipInstruction(); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region F instruction branch
+/*==================================================================*/
+
+	// FX07 - set VX = delay timer
+	void instruction_Fx07(const s32 X) {
+		mRegisterV[X] = mDelayTimer;
+	}
+	// FX0A - set VX = key, wait for keypress
+	void instruction_Fx0A(const s32 X) {
+		setInterrupt(Interrupt::INPUT);
+		mInputReg = static_cast<u8>(X);
+		flushBuffers(FlushType::DISPLAY);
+	}
+	// FX15 - set delay timer = VX
+	void instruction_Fx15(const s32 X) {
+		mDelayTimer = mRegisterV[X];
+	}
+	// FX18 - set sound timer = VX
+	void instruction_Fx18(const s32 X) {
+		mAudioTone  = calcAudioTone();
+		mSoundTimer = mRegisterV[X] + (mRegisterV[X] == 1);
+	}
+	// FX1E - set I = I + VX
+	void instruction_Fx1E(const s32 X) {
+		mRegisterI += mRegisterV[X];
+	}
+	// FX29 - point I to 5 byte hex sprite from value in VX
+	void instruction_Fx29(const s32 X) {
+		mRegisterI = (mRegisterV[X] & 0xF) * 5;
+	}
+	// FX30 - point I to 10 byte hex sprite from value in VX
+	void instruction_Fx30(const s32 X) {
+		mRegisterI = (mRegisterV[X] & 0xF) * 10 + 80;
+	}
+	// FX33 - store BCD of VX to RAM at I, I+1, I+2
+	void instruction_Fx33(const s32 X) {
+		writeMemoryI(mRegisterV[X] / 100,     0);
+		writeMemoryI(mRegisterV[X] / 10 % 10, 1);
+		writeMemoryI(mRegisterV[X]      % 10, 2);
+	}
+	// FX55 - store V0..VX to RAM at I..I+X
+	void instruction_Fx55(const s32 X) {
+		for (auto idx{ 0 }; idx <= X; ++idx)
+			{ writeMemoryI(mRegisterV[idx], idx); }
+		if (!Quirk.idxRegNoInc) [[likely]]
+			{ mRegisterI += X + !Quirk.idxRegMinus; }
+	}
+	// FX65 - load V0..VX from RAM at I..I+X
+	void instruction_Fx65(const s32 X) {
+		for (auto idx{ 0 }; idx <= X; ++idx)
+			{ mRegisterV[idx] = readMemoryI(idx); }
+		if (!Quirk.idxRegNoInc) [[likely]]
+			{ mRegisterI += X + !Quirk.idxRegMinus; }
+	}
+	// FX75 - store V0..VX to the P flags
+	void instruction_Fx75(const s32 X) {
+		if (writePermRegs(mRegisterV, X + 1)) [[unlikely]]
+			{ operationError("Error :: Failed writing persistent registers!"); }
+	}
+	// FX85 - load V0..VX from the P flags
+	void instruction_Fx85(const s32 X) {
+		if (readPermRegs(mRegisterV, X + 1)) [[unlikely]]
+			{ operationError("Error :: Failed reading persistent registers!"); }
+	}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+};
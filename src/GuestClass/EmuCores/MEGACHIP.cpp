@@ -0,0 +1,607 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <cmath>
+#include <cstring>
+
+#include "MEGACHIP.hpp"
+
+#include "../../Assistants/JobSystem.hpp"
+
+#include "../../HostClass/HomeDirManager.hpp"
+#include "../../HostClass/BasicVideoSpec.hpp"
+#include "../../HostClass/BasicAudioSpec.hpp"
+
+
+
+MEGACHIP::~MEGACHIP() = default;
+MEGACHIP::MEGACHIP(
+	HomeDirManager& ref_HDM,
+	BasicVideoSpec& ref_BVS,
+	BasicAudioSpec& ref_BAS
+) noexcept
+	: EmuCores{ ref_HDM, ref_BVS, ref_BAS }
+{
+	Pages.track(mMemoryBank);
+
+	copyGameToMemory(mMemoryBank.data(), cGameLoadPos);
+	copyFontToMemory(mMemoryBank.data(), 0, 240);
+	std::copy_n(cFontDataMega, 160, mMemoryBank.data() + 240);
+
+	mProgCounter    = cStartOffset;
+	mFramerate      = cRefreshRate;
+	mCyclesPerFrame = cInstSpeedHi;
+
+	Quirk.waitScroll  = true;
+	Quirk.idxRegNoInc = true;
+	Quirk.shiftVX     = true;
+	Quirk.jmpRegX     = true;
+
+	for (auto i{ 0 }; i < 10; ++i) {
+		const auto mult{ 1.0f - 0.045f * i };
+		mCharColors[i] = 0xFF000000
+			| static_cast<u32>(std::min(std::round(255.0f * mult * 1.03f), 255.0f)) << 16
+			| static_cast<u32>(std::min(std::round(255.0f * mult * 1.14f), 255.0f)) <<  8
+			| static_cast<u32>(std::min(std::round(255.0f * mult * 1.21f), 255.0f));
+	}
+	chooseBlend(0);
+
+	initPlatform();
+}
+
+void MEGACHIP::processFrame() {
+	if (isSystemStopped()) { return; }
+	else { ++mTotalFrames; }
+
+	Input.updateKeyStates();
+
+	if (mDelayTimer) { --mDelayTimer; }
+	if (mSoundTimer) { --mSoundTimer; }
+
+	handlePreFrameInterrupt();
+
+	instructionLoop();
+
+	handleEndFrameInterrupt();
+
+	renderAudioData();
+
+	if (isManualRefresh()) { return; }
+
+	renderVideoData();
+}
+
+void MEGACHIP::saveCoreState(u8* dest) const noexcept {
+	std::memcpy(dest, static_cast<const MEGACHIP_State*>(this), sizeof(MEGACHIP_State));
+}
+
+void MEGACHIP::loadCoreState(const u8* src) {
+	MEGACHIP_State state;
+	std::memcpy(&state, src, sizeof(state));
+
+	const auto resolution{ mResolution };
+	static_cast<MEGACHIP_State&>(*this) = state;
+
+	isManualRefresh(mResolution == Resolution::MC);
+	chooseBlend(mBlendMode);
+
+	// the host display is only set up anew when the mode changed, as it resizes the window
+	if (mResolution != resolution) {
+		BVS.setBackColor(isManualRefresh() ? 0 : cBitsColor[0]);
+		syncDisplayArea();
+	}
+	BVS.setTextureAlpha(mOpacity);
+
+	// returning from running ahead leaves the frame ahead on screen
+	if (mRunningAhead) { return; }
+
+	if (isManualRefresh()) {
+		std::copy_n(
+			mForegroundBuffer.data(),
+			mDisplaySize, BVS.lockTexture()
+		);
+		BVS.unlockTexture();
+	} else {
+		renderVideoData();
+	}
+}
+
+void MEGACHIP::handlePreFrameInterrupt() noexcept {
+	switch (mInterruptType)
+	{
+		case Interrupt::FRAME:
+			mInterruptType  = Interrupt::CLEAR;
+			mCyclesPerFrame = std::abs(mCyclesPerFrame);
+			return;
+
+		case Interrupt::SOUND:
+			if (!mSoundTimer) {
+				mInterruptType = Interrupt::FINAL;
+				mCyclesPerFrame = 0;
+			}
+			return;
+	}
+}
+
+void MEGACHIP::handleEndFrameInterrupt() noexcept {
+	switch (mInterruptType)
+	{
+		case Interrupt::INPUT:
+			if (Input.keyPressed(mRegisterV[mInputReg], mTotalFrames)) {
+				mInterruptType  = Interrupt::CLEAR;
+				mCyclesPerFrame = std::abs(mCyclesPerFrame);
+				mAudioTone      = calcAudioTone();
+				mSoundTimer     = 2;
+			}
+			return;
+
+		case Interrupt::ERROR:
+		case Interrupt::FINAL:
+			mCyclesPerFrame = 0;
+			return;
+	}
+}
+
+constexpr MEGACHIP::Opcode MEGACHIP::classifyOpcode(const u32 HI, const u32 LO) noexcept {
+	using enum Opcode;
+	switch (HI >> 4) {
+		case 0x0:
+			switch (HI) {
+				case 0x00: break;
+				case 0x01: return _01NN;
+				case 0x02: return _02NN;
+				case 0x03: return _03NN;
+				case 0x04: return _04NN;
+				case 0x05: return _05NN;
+				case 0x06: return LO & 0xF0 ? ERROR_OPCODE : _060N;
+				case 0x07: return LO        ? ERROR_OPCODE : _0700;
+				case 0x08: return LO & 0xF0 ? ERROR_OPCODE : _080N;
+				case 0x09: return _09NN;
+				default:   return ERROR_00NN;
+			}
+			switch (LO & 0xF0) {
+				case 0xB0: return _00BN;
+				case 0xC0: return _00CN;
+			}
+			switch (LO) {
+				case 0x10: return _0010;
+				case 0x11: return _0011;
+				case 0xE0: return _00E0;
+				case 0xEE: return _00EE;
+				case 0xFB: return _00FB;
+				case 0xFC: return _00FC;
+				case 0xFD: return _00FD;
+				case 0xFE: return _00FE;
+				case 0xFF: return _00FF;
+				default:   return ERROR_00NN;
+			}
+		case 0x1: return _1NNN;
+		case 0x2: return _2NNN;
+		case 0x3: return _3xNN;
+		case 0x4: return _4xNN;
+		case 0x5: return LO & 0xF ? ERROR_OPCODE : _5xy0;
+		case 0x6: return _6xNN;
+		case 0x7: return _7xNN;
+		case 0x8:
+			switch (LO & 0xF) {
+				case 0x0: return _8xy0;
+				case 0x1: return _8xy1;
+				case 0x2: return _8xy2;
+				case 0x3: return _8xy3;
+				case 0x4: return _8xy4;
+				case 0x5: return _8xy5;
+				case 0x7: return _8xy7;
+				case 0x6: return _8xy6;
+				case 0xE: return _8xyE;
+				default:  return ERROR_OPCODE;
+			}
+		case 0x9: return LO & 0xF ? ERROR_OPCODE : _9xy0;
+		case 0xA: return _ANNN;
+		case 0xB: return _BXNN;
+		case 0xC: return _CxNN;
+		case 0xD: return _DxyN;
+		case 0xE:
+			switch (LO) {
+				case 0x9E: return _Ex9E;
+				case 0xA1: return _ExA1;
+				default:   return ERROR_OPCODE;
+			}
+		default:
+			switch (LO) {
+				case 0x07: return _Fx07;
+				case 0x0A: return _Fx0A;
+				case 0x15: return _Fx15;
+				case 0x18: return _Fx18;
+				case 0x1E: return _Fx1E;
+				case 0x29: return _Fx29;
+				case 0x30: return _Fx30;
+				case 0x33: return _Fx33;
+				case 0x55: return _Fx55;
+				case 0x65: return _Fx65;
+				case 0x75: return _Fx75;
+				case 0x85: return _Fx85;
+				default:   return ERROR_OPCODE;
+			}
+	}
+}
+
+const std::array<MEGACHIP::Opcode, 0x10000>
+	MEGACHIP::cOpcodeTable{ makeOpcodeTable<Opcode>(classifyOpcode) };
+
+void MEGACHIP::instructionLoop() {
+
+	auto cycleCount{ 0 };
+	for (; cycleCount < mCyclesPerFrame; ++cycleCount) {
+		const auto HI{ readMemory(mProgCounter++) };
+		const auto LO{ readMemory(mProgCounter++) };
+
+		using enum Opcode;
+		switch (cOpcodeTable[HI << 8 | LO]) {
+			case _0010: instruction_0010();                         break;
+			case _0011: instruction_0011();                         break;
+			case _00BN: instruction_00BN(LO & 0xF);                 break;
+			case _00CN: instruction_00CN(LO & 0xF);                 break;
+			case _00E0: instruction_00E0();                         break;
+			case _00EE: instruction_00EE();                         break;
+			case _00FB: instruction_00FB();                         break;
+			case _00FC: instruction_00FC();                         break;
+			case _00FD: instruction_00FD();                         break;
+			case _00FE: instruction_00FE();                         break;
+			case _00FF: instruction_00FF();                         break;
+			case _01NN: instruction_01NN(LO);                       break;
+			case _02NN: instruction_02NN(LO);                       break;
+			case _03NN: instruction_03NN(LO);                       break;
+			case _04NN: instruction_04NN(LO);                       break;
+			case _05NN: instruction_05NN(LO);                       break;
+			case _060N: instruction_060N(LO & 0xF);                 break;
+			case _0700: instruction_0700();                         break;
+			case _080N: instruction_080N(LO & 0xF);                 break;
+			case _09NN: instruction_09NN(LO);                       break;
+			case _1NNN: instruction_1NNN((HI << 8 | LO) & 0xFFF);   break;
+			case _2NNN: instruction_2NNN((HI << 8 | LO) & 0xFFF);   break;
+			case _3xNN: instruction_3xNN(HI & 0xF, LO);             break;
+			case _4xNN: instruction_4xNN(HI & 0xF, LO);             break;
+			case _5xy0: instruction_5xy0(HI & 0xF, LO >> 4);        break;
+			case _6xNN: instruction_6xNN(HI & 0xF, LO);             break;
+			case _7xNN: instruction_7xNN(HI & 0xF, LO);             break;
+			case _8xy0: instruction_8xy0(HI & 0xF, LO >> 4);        break;
+			case _8xy1: instruction_8xy1(HI & 0xF, LO >> 4);        break;
+			case _8xy2: instruction_8xy2(HI & 0xF, LO >> 4);        break;
+			case _8xy3: instruction_8xy3(HI & 0xF, LO >> 4);        break;
+			case _8xy4: instruction_8xy4(HI & 0xF, LO >> 4);        break;
+			case _8xy5: instruction_8xy5(HI & 0xF, LO >> 4);        break;
+			case _8xy7: instruction_8xy7(HI & 0xF, LO >> 4);        break;
+			case _8xy6: instruction_8xy6(HI & 0xF, LO >> 4);        break;
+			case _8xyE: instruction_8xyE(HI & 0xF, LO >> 4);        break;
+			case _9xy0: instruction_9xy0(HI & 0xF, LO >> 4);        break;
+			case _ANNN: instruction_ANNN((HI << 8 | LO) & 0xFFF);   break;
+			case _BXNN: instruction_BXNN(HI & 0xF, (HI << 8 | LO) & 0xFFF); break;
+			case _CxNN: instruction_CxNN(HI & 0xF, LO);             break;
+			case _DxyN: instruction_DxyN(HI & 0xF, LO >> 4, LO & 0xF); break;
+			case _Ex9E: instruction_Ex9E(HI & 0xF);                 break;
+			case _ExA1: instruction_ExA1(HI & 0xF);                 break;
+			case _Fx07: instruction_Fx07(HI & 0xF);                 break;
+			case _Fx0A: instruction_Fx0A(HI & 0xF);                 break;
+			case _Fx15: instruction_Fx15(HI & 0xF);                 break;
+			case _Fx18: instruction_Fx18(HI & 0xF);                 break;
+			case _Fx1E: instruction_Fx1E(HI & 0xF);                 break;
+			case _Fx29: instruction_Fx29(HI & 0xF);                 break;
+			case _Fx30: instruction_Fx30(HI & 0xF);                 break;
+			case _Fx33: instruction_Fx33(HI & 0xF);                 break;
+			case _Fx55: instruction_Fx55(HI & 0xF);                 break;
+			case _Fx65: instruction_Fx65(HI & 0xF);                 break;
+			case _Fx75: instruction_Fx75(HI & 0xF);                 break;
+			case _Fx85: instruction_Fx85(HI & 0xF);                 break;
+			[[unlikely]]
+			case ERROR_00NN: instructionErrorML(HI, LO);            break;
+			[[unlikely]]
+			default:         instructionError(HI, LO);              break;
+		}
+	}
+	mTotalCycles += cycleCount;
+}
+
+void MEGACHIP::jumpProgramTo(const s32 next) noexcept {
+	if (mProgCounter - 2 == next) [[unlikely]] {
+		setInterrupt(Interrupt::SOUND);
+	} else { mProgCounter = static_cast<u16>(next); }
+}
+
+f32  MEGACHIP::calcAudioTone() const {
+	return (160.0f + 8.0f * (
+		(mProgCounter >> 1) + mStackBank[mStackTop] + 1 & 0x3E)
+	) / BAS.getFrequency();
+}
+
+void MEGACHIP::renderAudioData() {
+	std::vector<s16> audioBuffer(static_cast<usz>(BAS.getFrequency() / cRefreshRate));
+
+	if (mSoundTimer) {
+		const auto amplitute{ BAS.getAmplitude() };
+		for (auto& sample_s16 : audioBuffer) {
+			sample_s16 = mWavePhase > 0.5f ? amplitute : -amplitute;
+			mWavePhase = std::fmod(mWavePhase + mAudioTone, 1.0f);
+		}
+		BVS.setFrameColor(cBitsColor[0], cBitsColor[1]);
+	} else if (mTrack.mTrackLen) {
+		const auto volume{ BAS.getVolume() };
+		for (auto& sample_s16 : audioBuffer) {
+			sample_s16 = static_cast<s16>((readMemory(
+				mTrack.mMemPoint + static_cast<u32>(mTrack.mTrackPos)
+			) - 128) * volume);
+
+			if ((mTrack.mTrackPos += mTrack.mStepping) >= std::abs(mTrack.mTrackLen)) {
+				if (mTrack.mTrackLen < 0) {
+					mTrack.mTrackPos += mTrack.mTrackLen;
+				} else {
+					resetAudioTrack();
+					break;
+				}
+			}
+		}
+		BVS.setFrameColor(0xFF202020, 0xFF202020);
+	} else {
+		mWavePhase = 0.0f;
+		BVS.setFrameColor(cBitsColor[0], cBitsColor[0]);
+	}
+	if (!mRunningAhead) {
+		BAS.pushAudioData(audioBuffer.data(), audioBuffer.size());
+	}
+}
+
+void MEGACHIP::resetAudioTrack() noexcept {
+	mTrack = {};
+}
+
+void MEGACHIP::startAudioTrack(const bool repeat) noexcept {
+	mTrack.mTrackLen = readMemoryI(2) << 16
+					 | readMemoryI(3) <<  8
+					 | readMemoryI(4);
+
+	if (!mTrack.mTrackLen) {
+		resetAudioTrack();
+		return;
+	}
+
+	mTrack.mStepping = (readMemoryI(0) << 8 | readMemoryI(1)) * 1.0 / BAS.getFrequency();
+	mTrack.mTrackLen = repeat ? -mTrack.mTrackLen : mTrack.mTrackLen;
+	mTrack.mTrackPos = 0.0;
+	mTrack.mMemPoint = mRegisterI + 6;
+}
+
+void MEGACHIP::renderVideoData() {
+	std::transform(
+		std::execution::unseq,
+		mDisplayBuffer.begin(),
+		mDisplayBuffer.begin() + mDisplaySize,
+		BVS.lockTexture(),
+		[](const auto pixel) noexcept {
+			return 0xFF000000 | cBitsColor[pixel];
+		}
+	);
+	BVS.unlockTexture();
+}
+
+void MEGACHIP::syncDisplayArea() {
+	const auto W{ mResolution == Resolution::MC ? 256 : mResolution == Resolution::HI ? 128 : 64 };
+	const auto H{ mResolution == Resolution::MC ? 192 : mResolution == Resolution::HI ?  64 : 32 };
+
+	isLoresExtended(mResolution == Resolution::LO);
+
+	if (W != mDisplayW) {
+		setDisplayResolution(W, H);
+		BVS.createTexture(mDisplayW, mDisplayH);
+		BVS.setTextureAlpha(mOpacity);
+	}
+	if (mResolution == Resolution::MC) {
+		BVS.setAspectRatio(512, 384, -2);
+	} else {
+		BVS.setAspectRatio(512, 256, +2);
+	}
+}
+
+void MEGACHIP::prepDisplayArea(const Resolution mode) {
+	mResolution = mode;
+	syncDisplayArea();
+
+	std::fill(
+		std::execution::unseq,
+		mDisplayBuffer.begin(),
+		mDisplayBuffer.end(),
+		u8()
+	);
+}
+
+void MEGACHIP::setMegaMode(const bool state) {
+	setInterrupt(Interrupt::FRAME);
+
+	isManualRefresh(state);
+	resetAudioTrack();
+
+	flushBuffers(FlushType::DISCARD);
+	prepDisplayArea(state ? Resolution::MC : Resolution::LO);
+	setDisplayOpacity(0xFF);
+	BVS.setBackColor(state ? 0 : cBitsColor[0]);
+}
+
+void MEGACHIP::setDisplayOpacity(const s32 alpha) {
+	mOpacity = static_cast<u8>(alpha);
+	BVS.setTextureAlpha(mOpacity);
+}
+
+void MEGACHIP::flushBuffers(const FlushType option) {
+	switch (option) {
+		case FlushType::DISCARD:
+			mColorPalette.fill(0);
+			mBackgroundBuffer.fill(0);
+			mCollisionMap.fill(0);
+			break;
+
+		case FlushType::DISPLAY:
+			mForegroundBuffer = mBackgroundBuffer;
+			mBackgroundBuffer.fill(0);
+			mCollisionMap.fill(0);
+			std::copy_n(
+				mForegroundBuffer.data(),
+				mDisplaySize, BVS.lockTexture()
+			);
+			BVS.unlockTexture();
+			break;
+	}
+}
+
+namespace {
+	constexpr f32 minF{ 1.0f / 255.0f };
+
+	u32 blendPixel(
+		const u32 srcPixel, const u32 dstPixel, const f32 alpha,
+		f32(*blend)(const f32, const f32) noexcept
+	) noexcept {
+		const auto srcA{ (srcPixel >> 24) * alpha * minF };
+		if (srcA < minF) [[unlikely]] { return dstPixel; }
+
+		const auto srcR{ (srcPixel >> 16 & 0xFF) * minF };
+		const auto srcG{ (srcPixel >>  8 & 0xFF) * minF };
+		const auto srcB{ (srcPixel       & 0xFF) * minF };
+
+		const auto dstR{ (dstPixel >> 16 & 0xFF) * minF };
+		const auto dstG{ (dstPixel >>  8 & 0xFF) * minF };
+		const auto dstB{ (dstPixel       & 0xFF) * minF };
+
+		auto R{ blend(srcR, dstR) };
+		auto G{ blend(srcG, dstG) };
+		auto B{ blend(srcB, dstB) };
+
+		if (srcA < 1.0f) {
+			R = (1.0f - srcA) * dstR + srcA * R;
+			G = (1.0f - srcA) * dstG + srcA * G;
+			B = (1.0f - srcA) * dstB + srcA * B;
+		}
+
+		return 0xFF000000
+			| static_cast<u8>(std::roundf(R * 255.0f)) << 16
+			| static_cast<u8>(std::roundf(G * 255.0f)) <<  8
+			| static_cast<u8>(std::roundf(B * 255.0f));
+	}
+}
+
+void MEGACHIP::chooseBlend(const s32 N) noexcept {
+	mBlendMode = static_cast<u8>(N);
+	switch (N) {
+		case 4: // linear dodge
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return std::min(src + dst, 1.0f);
+			};
+			break;
+
+		case 5: // multiply
+			mBlendAlgo = [](const f32 src, const f32 dst) noexcept {
+				return src * dst;
+			};
+			break;
+
+		default: // normal
+			mBlendAlgo = [](const f32 src, const f32) noexcept {
+				return src;
+			};
+			break;
+	}
+}
+
+// rows of the display blended per job, and how long those took
+static constexpr usz cBlendRows{ 32 };
+static JobSystem::Timer sBlendTimer;
+
+void MEGACHIP::blendBuffersToTexture() {
+	auto* const texture{ BVS.lockTexture() };
+	bjs::jobs.parallel_for(0, static_cast<usz>(mDisplayH), cBlendRows,
+		[&](const usz rowBegin, const usz rowEnd) noexcept {
+			const auto first{ rowBegin * mDisplayW };
+			const auto last { rowEnd   * mDisplayW };
+			std::transform(
+				mForegroundBuffer.begin() + first,
+				mForegroundBuffer.begin() + last,
+				mBackgroundBuffer.begin() + first,
+				texture + first,
+				[this](const u32 src, const u32 dst) noexcept {
+					return blendPixel(src, dst, Texture.alpha, mBlendAlgo);
+				}
+			);
+		}, &sBlendTimer
+	);
+	BVS.unlockTexture();
+}
+
+void MEGACHIP::drawSpriteMega(const s32 X, const s32 Y, const s32 N) {
+	const s32 VX{ mRegisterV[X] };
+	const s32 VY{ mRegisterV[Y] };
+
+	mRegisterV[0xF] = 0;
+	if (!Quirk.wrapSprite && VY >= mDisplayH) { return; }
+
+	if (mRegisterI < 0xF0) [[unlikely]] {
+		// font sprites are drawn as plain 8 pixel rows
+		for (auto H{ 0 }, pY{ VY }; H < N; ++H, ++pY &= mDisplayWb)
+		{
+			if (Quirk.wrapSprite && pY >= mDisplayH) { continue; }
+			const auto bytePixel{ readMemoryI(H) };
+
+			for (auto W{ 7 }, pX{ VX }; W >= 0; --W, ++pX &= mDisplayWb)
+			{
+				if (bytePixel >> W & 0x1)
+				{
+					auto& collideCoord{ mCollisionMap[pY * mDisplayW + pX] };
+					auto& backbufCoord{ mBackgroundBuffer[pY * mDisplayW + pX] };
+
+					if (collideCoord) [[unlikely]] {
+						collideCoord = 0;
+						backbufCoord = 0;
+						mRegisterV[0xF] = 1;
+					} else {
+						collideCoord = 254;
+						backbufCoord = mCharColors[std::min(H, 9)];
+					}
+				}
+				if (!Quirk.wrapSprite && pX == mDisplayWb) { break; }
+			}
+			if (!Quirk.wrapSprite && pY == mDisplayHb) { break; }
+		}
+		return;
+	}
+
+	for (auto H{ 0 }, pY{ VY }; H < Texture.H; ++H, ++pY &= mDisplayWb)
+	{
+		if (Quirk.wrapSprite && pY >= mDisplayH) { continue; }
+		auto I{ H * Texture.W };
+
+		for (auto W{ 0 }, pX{ VX }; W < Texture.W; ++W, ++pX &= mDisplayWb)
+		{
+			if (const auto sourceColorIdx{ readMemoryI(I++) }; sourceColorIdx)
+			{
+				auto& collideCoord{ mCollisionMap[pY * mDisplayW + pX] };
+				auto& backbufCoord{ mBackgroundBuffer[pY * mDisplayW + pX] };
+
+				if (collideCoord == Texture.collision)
+					[[unlikely]] { mRegisterV[0xF] = 1; }
+
+				collideCoord = sourceColorIdx;
+				backbufCoord = blendPixel(
+					mColorPalette[sourceColorIdx],
+					backbufCoord, Texture.alpha,
+					mBlendAlgo
+				);
+			}
+			if (!Quirk.wrapSprite && pX == mDisplayWb) { break; }
+		}
+		if (!Quirk.wrapSprite && pY == mDisplayHb) { break; }
+	}
+}
+
+void MEGACHIP::initPlatform() {
+	setDisplayResolution(0, 0); // the host may have shown another core since
+	BVS.setBackColor(cBitsColor[0]);
+	prepDisplayArea(Resolution::LO);
+}
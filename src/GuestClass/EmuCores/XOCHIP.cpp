@@ -0,0 +1,414 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "../DispatchEngine.hpp"
+
+#if defined(CUBECHIP_XO_SSSE3)
+	#include <immintrin.h>
+#endif
+
+#include "XOCHIP.hpp"
+
+#include "../../HostClass/HomeDirManager.hpp"
+#include "../../HostClass/BasicVideoSpec.hpp"
+#include "../../HostClass/BasicAudioSpec.hpp"
+
+namespace {
+
+#if defined(CUBECHIP_XO_SSSE3)
+	// Color index bytes of 16 pixels, each pixel gathering one bit per plane
+	__m128i gatherIndices(const u32 (&bits)[4]) noexcept {
+		const auto select{ _mm_setr_epi8(1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0) };
+		const auto pixel{ _mm_setr_epi8(
+			-128, 64, 32, 16, 8, 4, 2, 1,
+			-128, 64, 32, 16, 8, 4, 2, 1
+		) };
+
+		auto index{ _mm_setzero_si128() };
+		for (auto P{ 0 }; P < 4; ++P) {
+			const auto spread{ _mm_shuffle_epi8(_mm_set1_epi16(static_cast<short>(bits[P])), select) };
+			const auto isSet{ _mm_cmpeq_epi8(_mm_and_si128(spread, pixel), pixel) };
+			index = _mm_or_si128(index, _mm_and_si128(isSet, _mm_set1_epi8(static_cast<char>(1 << P))));
+		}
+		return index;
+	}
+#else
+	// Each bit of a byte spread to the lowest bit of its own byte, leftmost first
+	constexpr auto cSpreadBits{ [] {
+		std::array<u64, 256> table{};
+		for (auto byte{ 0u }; byte < 256; ++byte) {
+			for (auto B{ 0u }; B < 8; ++B) {
+				table[byte] |= u64(byte >> (7 - B) & 1) << B * 8;
+			}
+		}
+		return table;
+	}() };
+#endif
+
+}
+
+
+
+XOCHIP::~XOCHIP() = default;
+XOCHIP::XOCHIP(
+	HomeDirManager& ref_HDM,
+	BasicVideoSpec& ref_BVS,
+	BasicAudioSpec& ref_BAS
+) noexcept
+	: EmuCores{ ref_HDM, ref_BVS, ref_BAS }
+{
+	copyGameToMemory(mMemoryBank.data(), cGameLoadPos);
+	copyFontToMemory(mMemoryBank.data(), 0, 240);
+
+	mProgCounter    = cStartOffset;
+	mFramerate      = cRefreshRate;
+	mCyclesPerFrame = cInstSpeedHi;
+
+	mPatternStep = 4000.0f / 128.0f / BAS.getFrequency();
+	mPatternTone = mPatternStep;
+
+	Quirk.wrapSprite = true;
+
+	initPlatform();
+}
+
+void XOCHIP::processFrame() {
+	if (isSystemStopped()) { return; }
+	else { ++mTotalFrames; }
+
+	Input.updateKeyStates();
+
+	if (mDelayTimer) { --mDelayTimer; }
+	if (mSoundTimer) { --mSoundTimer; }
+
+	handlePreFrameInterrupt();
+
+	instructionLoop();
+
+	handleEndFrameInterrupt();
+
+	renderAudioData();
+
+	renderVideoData();
+}
+
+void XOCHIP::handlePreFrameInterrupt() noexcept {
+	switch (mInterruptType)
+	{
+		case Interrupt::FRAME:
+			mInterruptType  = Interrupt::CLEAR;
+			mCyclesPerFrame = std::abs(mCyclesPerFrame);
+			return;
+
+		case Interrupt::SOUND:
+			if (!mSoundTimer) {
+				mInterruptType = Interrupt::FINAL;
+				mCyclesPerFrame = 0;
+			}
+			return;
+	}
+}
+
+void XOCHIP::handleEndFrameInterrupt() noexcept {
+	switch (mInterruptType)
+	{
+		case Interrupt::INPUT:
+			if (Input.keyPressed(mRegisterV[mInputReg], mTotalFrames)) {
+				mInterruptType  = Interrupt::CLEAR;
+				mCyclesPerFrame = std::abs(mCyclesPerFrame);
+				mAudioTone      = calcAudioTone();
+				mSoundTimer     = 2;
+			}
+			return;
+
+		case Interrupt::ERROR:
+		case Interrupt::FINAL:
+			mCyclesPerFrame = 0;
+			return;
+	}
+}
+
+constexpr XOCHIP::Opcode XOCHIP::classifyOpcode(const u32 HI, const u32 LO) noexcept {
+	using enum Opcode;
+	switch (HI >> 4) {
+		case 0x0:
+			if (HI == 0x00 && (LO & 0xF0) == 0xC0) { return _00CN; }
+			if (HI == 0x00 && (LO & 0xF0) == 0xD0) { return _00DN; }
+			switch (HI << 8 | LO) {
+				case 0x00E0: return _00E0;
+				case 0x00EE: return _00EE;
+				case 0x00FB: return _00FB;
+				case 0x00FC: return _00FC;
+				case 0x00FD: return _00FD;
+				case 0x00FE: return _00FE;
+				case 0x00FF: return _00FF;
+				default:     return ERROR_00NN;
+			}
+		case 0x1: return _1NNN;
+		case 0x2: return _2NNN;
+		case 0x3: return _3xNN;
+		case 0x4: return _4xNN;
+		case 0x5:
+			switch (LO & 0xF) {
+				case 0x0: return _5xy0;
+				case 0x2: return _5xy2;
+				case 0x3: return _5xy3;
+				case 0x4: return _5xy4;
+				default:  return ERROR_OPCODE;
+			}
+		case 0x6: return _6xNN;
+		case 0x7: return _7xNN;
+		case 0x8:
+			switch (LO & 0xF) {
+				case 0x0: return _8xy0;
+				case 0x1: return _8xy1;
+				case 0x2: return _8xy2;
+				case 0x3: return _8xy3;
+				case 0x4: return _8xy4;
+				case 0x5: return _8xy5;
+				case 0x7: return _8xy7;
+				case 0x6: return _8xy6;
+				case 0xE: return _8xyE;
+				default:  return ERROR_OPCODE;
+			}
+		case 0x9: return LO & 0xF ? ERROR_OPCODE : _9xy0;
+		case 0xA: return _ANNN;
+		case 0xB: return _BXNN;
+		case 0xC: return _CxNN;
+		case 0xD: return _DxyN;
+		case 0xE:
+			switch (LO) {
+				case 0x9E: return _Ex9E;
+				case 0xA1: return _ExA1;
+				default:   return ERROR_OPCODE;
+			}
+		default:
+			switch (HI << 8 | LO) {
+				case 0xF000: return _F000;
+				case 0xF002: return _F002;
+			}
+			switch (LO) {
+				case 0x01: return _Fx01;
+				case 0x07: return _Fx07;
+				case 0x0A: return _Fx0A;
+				case 0x15: return _Fx15;
+				case 0x18: return _Fx18;
+				case 0x1E: return _Fx1E;
+				case 0x29: return _Fx29;
+				case 0x30: return _Fx30;
+				case 0x3A: return _Fx3A;
+				case 0x33: return _Fx33;
+				case 0x55: return _Fx55;
+				case 0x65: return _Fx65;
+				case 0x75: return _Fx75;
+				case 0x85: return _Fx85;
+				default:   return ERROR_OPCODE;
+			}
+	}
+}
+
+const std::array<XOCHIP::Opcode, 0x10000>
+	XOCHIP::cOpcodeTable{ makeOpcodeTable<Opcode>(classifyOpcode) };
+
+void XOCHIP::instructionLoop() {
+
+	auto cycleCount{ 0 };
+	for (; cycleCount < mCyclesPerFrame; ++cycleCount) {
+		const auto HI{ readMemory(mProgCounter++) };
+		const auto LO{ readMemory(mProgCounter++) };
+
+		using enum Opcode;
+		switch (cOpcodeTable[HI << 8 | LO]) {
+			case _00CN: instruction_00CN(LO & 0xF);                 break;
+			case _00DN: instruction_00DN(LO & 0xF);                 break;
+			case _00E0: instruction_00E0();                         break;
+			case _00EE: instruction_00EE();                         break;
+			case _00FB: instruction_00FB();                         break;
+			case _00FC: instruction_00FC();                         break;
+			case _00FD: instruction_00FD();                         break;
+			case _00FE: instruction_00FE();                         break;
+			case _00FF: instruction_00FF();                         break;
+			case _1NNN: instruction_1NNN((HI << 8 | LO) & 0xFFF);   break;
+			case _2NNN: instruction_2NNN((HI << 8 | LO) & 0xFFF);   break;
+			case _3xNN: instruction_3xNN(HI & 0xF, LO);             break;
+			case _4xNN: instruction_4xNN(HI & 0xF, LO);             break;
+			case _5xy0: instruction_5xy0(HI & 0xF, LO >> 4);        break;
+			case _5xy2: instruction_5xy2(HI & 0xF, LO >> 4);        break;
+			case _5xy3: instruction_5xy3(HI & 0xF, LO >> 4);        break;
+			case _5xy4: instruction_5xy4(HI & 0xF, LO >> 4);        break;
+			case _6xNN: instruction_6xNN(HI & 0xF, LO);             break;
+			case _7xNN: instruction_7xNN(HI & 0xF, LO);             break;
+			case _8xy0: instruction_8xy0(HI & 0xF, LO >> 4);        break;
+			case _8xy1: instruction_8xy1(HI & 0xF, LO >> 4);        break;
+			case _8xy2: instruction_8xy2(HI & 0xF, LO >> 4);        break;
+			case _8xy3: instruction_8xy3(HI & 0xF, LO >> 4);        break;
+			case _8xy4: instruction_8xy4(HI & 0xF, LO >> 4);        break;
+			case _8xy5: instruction_8xy5(HI & 0xF, LO >> 4);        break;
+			case _8xy7: instruction_8xy7(HI & 0xF, LO >> 4);        break;
+			case _8xy6: instruction_8xy6(HI & 0xF, LO >> 4);        break;
+			case _8xyE: instruction_8xyE(HI & 0xF, LO >> 4);        break;
+			case _9xy0: instruction_9xy0(HI & 0xF, LO >> 4);        break;
+			case _ANNN: instruction_ANNN((HI << 8 | LO) & 0xFFF);   break;
+			case _BXNN: instruction_BXNN(HI & 0xF, (HI << 8 | LO) & 0xFFF); break;
+			case _CxNN: instruction_CxNN(HI & 0xF, LO);             break;
+			case _DxyN: instruction_DxyN(HI & 0xF, LO >> 4, LO & 0xF); break;
+			case _Ex9E: instruction_Ex9E(HI & 0xF);                 break;
+			case _ExA1: instruction_ExA1(HI & 0xF);                 break;
+			case _F000: instruction_F000();                         break;
+			case _F002: instruction_F002();                         break;
+			case _Fx01: instruction_Fx01(HI & 0xF);                 break;
+			case _Fx07: instruction_Fx07(HI & 0xF);                 break;
+			case _Fx0A: instruction_Fx0A(HI & 0xF);                 break;
+			case _Fx15: instruction_Fx15(HI & 0xF);                 break;
+			case _Fx18: instruction_Fx18(HI & 0xF);                 break;
+			case _Fx1E: instruction_Fx1E(HI & 0xF);                 break;
+			case _Fx29: instruction_Fx29(HI & 0xF);                 break;
+			case _Fx30: instruction_Fx30(HI & 0xF);                 break;
+			case _Fx3A: instruction_Fx3A(HI & 0xF);                 break;
+			case _Fx33: instruction_Fx33(HI & 0xF);                 break;
+			case _Fx55: instruction_Fx55(HI & 0xF);                 break;
+			case _Fx65: instruction_Fx65(HI & 0xF);                 break;
+			case _Fx75: instruction_Fx75(HI & 0xF);                 break;
+			case _Fx85: instruction_Fx85(HI & 0xF);                 break;
+			[[unlikely]]
+			case ERROR_00NN: instructionErrorML(HI, LO);            break;
+			[[unlikely]]
+			default:         instructionError(HI, LO);              break;
+		}
+	}
+	mTotalCycles += cycleCount;
+}
+
+void XOCHIP::jumpProgramTo(const s32 next) noexcept {
+	if (mProgCounter - 2 == next) [[unlikely]] {
+		setInterrupt(Interrupt::SOUND);
+	} else { mProgCounter = static_cast<u16>(next); }
+}
+
+f32  XOCHIP::calcAudioTone() const {
+	return (160.0f + 8.0f * (
+		(mProgCounter >> 1) + mStackBank[mStackTop] + 1 & 0x3E)
+	) / BAS.getFrequency();
+}
+
+void XOCHIP::renderAudioData() {
+	std::vector<s16> audioBuffer(static_cast<usz>(BAS.getFrequency() / cRefreshRate));
+
+	if (mSoundTimer) {
+		const auto amplitute{ BAS.getAmplitude() };
+		if (mAudioIsXO) {
+			for (auto& sample_s16 : audioBuffer) {
+				const auto step{ static_cast<s32>(std::clamp(mWavePhase * 128.0f, 0.0f, 127.0f)) };
+				sample_s16 = mPatternData[step >> 3] & 0x80 >> (step & 7) ? amplitute : -amplitute;
+				mWavePhase = std::fmod(mWavePhase + mPatternTone, 1.0f);
+			}
+		} else {
+			for (auto& sample_s16 : audioBuffer) {
+				sample_s16 = mWavePhase > 0.5f ? amplitute : -amplitute;
+				mWavePhase = std::fmod(mWavePhase + mAudioTone, 1.0f);
+			}
+		}
+		BVS.setFrameColor(mBitColors[0], mBitColors[1]);
+	} else {
+		mWavePhase = 0.0f;
+		BVS.setFrameColor(mBitColors[0], mBitColors[0]);
+	}
+	BAS.pushAudioData(audioBuffer.data(), audioBuffer.size());
+}
+
+void XOCHIP::renderVideoData() {
+	BVS.setBackColor(mBitColors[0]);
+	if (mDirtyFirst > mDirtyLast) { return; }
+
+	auto* texture{ BVS.lockTextureRows(mDirtyFirst, mDirtyLast) };
+
+#if defined(CUBECHIP_XO_SSSE3)
+	// palette split into one byte table per channel, looked up 16 pixels at a time
+	alignas(16) u8 channel[3][16];
+	for (auto idx{ 0 }; idx < 16; ++idx) {
+		channel[0][idx] = static_cast<u8>(mBitColors[idx] >>  0);
+		channel[1][idx] = static_cast<u8>(mBitColors[idx] >>  8);
+		channel[2][idx] = static_cast<u8>(mBitColors[idx] >> 16);
+	}
+	const auto blue { _mm_load_si128(reinterpret_cast<const __m128i*>(channel[0])) };
+	const auto green{ _mm_load_si128(reinterpret_cast<const __m128i*>(channel[1])) };
+	const auto red  { _mm_load_si128(reinterpret_cast<const __m128i*>(channel[2])) };
+	const auto alpha{ _mm_set1_epi8(-1) };
+
+	for (auto Y{ mDirtyFirst }; Y <= mDirtyLast; ++Y) {
+		for (auto X{ 0 }; X < mDisplayW; X += 16, texture += 16) {
+			const auto word { Y * cRowWords + (X >> 6) };
+			const auto shift{ 48 - (X & 63) };
+
+			const u32 bits[4]{
+				static_cast<u32>(mDisplayBuffer[0][word] >> shift & 0xFFFF),
+				static_cast<u32>(mDisplayBuffer[1][word] >> shift & 0xFFFF),
+				static_cast<u32>(mDisplayBuffer[2][word] >> shift & 0xFFFF),
+				static_cast<u32>(mDisplayBuffer[3][word] >> shift & 0xFFFF),
+			};
+			const auto index{ gatherIndices(bits) };
+
+			const auto B{ _mm_shuffle_epi8(blue,  index) };
+			const auto G{ _mm_shuffle_epi8(green, index) };
+			const auto R{ _mm_shuffle_epi8(red,   index) };
+
+			const auto BG_lo{ _mm_unpacklo_epi8(B, G) };
+			const auto BG_hi{ _mm_unpackhi_epi8(B, G) };
+			const auto RA_lo{ _mm_unpacklo_epi8(R, alpha) };
+			const auto RA_hi{ _mm_unpackhi_epi8(R, alpha) };
+
+			auto* dest{ reinterpret_cast<__m128i*>(texture) };
+			_mm_storeu_si128(dest + 0, _mm_unpacklo_epi16(BG_lo, RA_lo));
+			_mm_storeu_si128(dest + 1, _mm_unpackhi_epi16(BG_lo, RA_lo));
+			_mm_storeu_si128(dest + 2, _mm_unpacklo_epi16(BG_hi, RA_hi));
+			_mm_storeu_si128(dest + 3, _mm_unpackhi_epi16(BG_hi, RA_hi));
+		}
+	}
+#else
+	for (auto Y{ mDirtyFirst }; Y <= mDirtyLast; ++Y) {
+		for (auto X{ 0 }; X < mDisplayW; X += 8) {
+			const auto word { Y * cRowWords + (X >> 6) };
+			const auto shift{ 56 - (X & 63) };
+
+			// color indices of 8 pixels, one per byte
+			const auto index{
+				cSpreadBits[mDisplayBuffer[0][word] >> shift & 0xFF] << 0 |
+				cSpreadBits[mDisplayBuffer[1][word] >> shift & 0xFF] << 1 |
+				cSpreadBits[mDisplayBuffer[2][word] >> shift & 0xFF] << 2 |
+				cSpreadBits[mDisplayBuffer[3][word] >> shift & 0xFF] << 3
+			};
+			for (auto B{ 0 }; B < 8; ++B) {
+				*texture++ = 0xFF000000 | mBitColors[index >> B * 8 & 0xF];
+			}
+		}
+	}
+#endif
+	BVS.unlockTexture();
+	clearDirty();
+}
+
+void XOCHIP::prepDisplayArea(const Resolution mode) {
+	const auto lores{ mode == Resolution::LO };
+	isLoresExtended(lores);
+
+	const auto W{ lores ?  64 : 128 };
+	const auto H{ lores ?  32 :  64 };
+
+	if (W != mDisplayW) {
+		setDisplayResolution(W, H);
+		BVS.createTexture(mDisplayW, mDisplayH);
+		BVS.setAspectRatio(512, 256, +2);
+	}
+
+	for (auto& plane : mDisplayBuffer) { plane.fill(0); }
+	markAllDirty();
+}
+
+void XOCHIP::initPlatform() {
+	std::copy_n(cBitsColor, 16, mBitColors);
+	BVS.setBackColor(mBitColors[0]);
+	prepDisplayArea(Resolution::LO);
+}
@@ -11,17 +11,22 @@
 	#include "../_nlohmann/json.hpp"
 #pragma warning(pop)
 
+#include "EmuCores/CHIP8_LEGACY.hpp"
 #include "EmuCores/CHIP8_MODERN.hpp"
+#include "EmuCores/SCHIP_MODERN.hpp"
+#include "EmuCores/XOCHIP.hpp"
+#include "EmuCores/MEGACHIP.hpp"
+#include "EmuCores/GIGACHIP.hpp"
 
-std::string GameFileChecker::sErrorMsg{};
-GameCoreType GameFileChecker::sEmuCore{};
+thread_local std::string GameFileChecker::sErrorMsg{};
+thread_local GameCoreType GameFileChecker::sEmuCore{};
 
 std::unique_ptr<EmuCores> GameFileChecker::initializeCore(
 	HomeDirManager& HDM, BasicVideoSpec& BVS, BasicAudioSpec& BAS
 ) {
 	switch (sEmuCore) {
 		case GameCoreType::XOCHIP:
-			//return std::make_unique<XOCHIP>(HDM, BVS, BAS);
+			return std::make_unique<XOCHIP>(HDM, BVS, BAS);
 
 		case GameCoreType::CHIP8E:
 			//return std::make_unique<CHIP8E>(HDM, BVS, BAS);
@@ -36,7 +41,7 @@ std::unique_ptr<EmuCores> GameFileChecker::initializeCore(
 			//return std::make_unique<CHIP8_4P>(HDM, BVS, BAS);
 
 		case GameCoreType::CHIP8_LEGACY:
-			//return std::make_unique<CHIP8_LEGACY>(HDM, BVS, BAS);
+			return std::make_unique<CHIP8_LEGACY>(HDM, BVS, BAS);
 
 		case GameCoreType::SCHIP_LEGACY:
 			//return std::make_unique<SCHIP_LEGACY>(HDM, BVS, BAS);
@@ -45,7 +50,7 @@ std::unique_ptr<EmuCores> GameFileChecker::initializeCore(
 			return std::make_unique<CHIP8_MODERN>(HDM, BVS, BAS);
 
 		case GameCoreType::SCHIP_MODERN:
-			//return std::make_unique<SCHIP_MODERN>(HDM, BVS, BAS);
+			return std::make_unique<SCHIP_MODERN>(HDM, BVS, BAS);
 
 		case GameCoreType::CHIP8X_HIRES:
 			//return std::make_unique<CHIP8X_HIRES>(HDM, BVS, BAS);
@@ -55,12 +60,13 @@ std::unique_ptr<EmuCores> GameFileChecker::initializeCore(
 
 		case GameCoreType::HWCHIP64:
 			//return std::make_unique<HWCHIP64>(HDM, BVS, BAS);
+			return nullptr;
 
 		case GameCoreType::MEGACHIP:
-			//return std::make_unique<MEGACHIP>(HDM, BVS, BAS);
+			return std::make_unique<MEGACHIP>(HDM, BVS, BAS);
 
 		case GameCoreType::GIGACHIP:
-			//return std::make_unique<GIGACHIP>(HDM, BVS, BAS);
+			return std::make_unique<GIGACHIP>(HDM, BVS, BAS);
 
 		default:
 		case GameCoreType::INVALID:
@@ -82,6 +88,7 @@ bool GameFileChecker::validate(
 		{".c4h", GameFileType::c4h},
 		{".c8h", GameFileType::c8h},
 		{".ch8", GameFileType::ch8},
+		{".c8v", GameFileType::c8v},
 		{".sc8", GameFileType::sc8},
 		{".mc8", GameFileType::mc8},
 		{".gc8", GameFileType::gc8},
@@ -134,22 +141,19 @@ bool GameFileChecker::validate(
 
 		case (GameFileType::mc8):
 			return testGame(
-				true,
-				//MEGACHIP::testGameSize(size),
+				MEGACHIP::testGameSize(size),
 				GameCoreType::MEGACHIP
 			);
 
 		case (GameFileType::gc8):
 			return testGame(
-				true,
-				//GIGACHIP::testGameSize(size),
+				GIGACHIP::testGameSize(size),
 				GameCoreType::GIGACHIP
 			);
 
 		case (GameFileType::xo8):
 			return testGame(
-				true,
-				//XOCHIP::testGameSize(size),
+				XOCHIP::testGameSize(size),
 				GameCoreType::XOCHIP
 			);
 
@@ -180,10 +184,15 @@ bool GameFileChecker::validate(
 				GameCoreType::CHIP8_MODERN
 			);
 
+		case (GameFileType::c8v):
+			return testGame(
+				CHIP8_LEGACY::testGameSize(size),
+				GameCoreType::CHIP8_LEGACY
+			);
+
 		case (GameFileType::sc8):
 			return testGame(
-				true,
-				//SCHIP_MODERN::testGameSize(size),
+				SCHIP_MODERN::testGameSize(size),
 				GameCoreType::SCHIP_MODERN
 			);
 
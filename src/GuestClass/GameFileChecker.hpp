@@ -47,6 +47,7 @@ enum class GameFileType {
 	c4h, // CHIP-8 (HIRES) 4-page
 	c8h, // CHIP-8 (HIRES) 2-page patched
 	ch8, // CHIP-8
+	c8v, // CHIP-8 (COSMAC VIP timing)
 	sc8, // SUPERCHIP
 	mc8, // MEGACHIP
 	gc8, // GIGACHIP
@@ -75,10 +76,11 @@ class GameFileChecker final {
 	 GameFileChecker() = delete;
 	~GameFileChecker() = delete;
 
-	static std::string sErrorMsg;
-	static GameCoreType sEmuCore;
+	// per-thread so headless batch workers can validate in parallel
+	static thread_local std::string sErrorMsg;
+	static thread_local GameCoreType sEmuCore;
 
-	[[nodiscard]] static constexpr bool testGame(
+	[[nodiscard]] static bool testGame(
 		const bool pass, const GameCoreType type
 	) noexcept {
 		if (pass) { sEmuCore = type; }
@@ -86,20 +88,20 @@ class GameFileChecker final {
 	}
 
 public:
-	[[nodiscard]] static constexpr auto getError() noexcept {
+	[[nodiscard]] static auto getError() noexcept {
 		return std::move(sErrorMsg);
 	}
 
-	[[nodiscard]] static constexpr auto getCore()  noexcept {
+	[[nodiscard]] static auto getCore()  noexcept {
 		return sEmuCore;
 	}
 
-	static constexpr void delCore() noexcept {
+	static void delCore() noexcept {
 		sErrorMsg.clear();
 		sEmuCore = GameCoreType::INVALID;
 	}
 
-	[[nodiscard]] static constexpr bool hasCore()  noexcept {
+	[[nodiscard]] static bool hasCore()  noexcept {
 		return sEmuCore != GameCoreType::INVALID;
 	}
 
@@ -18,6 +18,7 @@ using namespace blogger;
 
 #include "Guest.hpp"
 #include "HexInput.hpp"
+#include "DispatchEngine.hpp"
 
 /*------------------------------------------------------------------*/
 /*  class  MEGACORE                                                 */
@@ -42,6 +43,18 @@ void MEGACORE::isSystemStopped(const bool state) { mSystemStopped = state; }
 
 void MEGACORE::instructionLoop() {
 
+#ifdef CUBECHIP_THREADED_DISPATCH
+	#define BRANCH(n) BRANCH_##n
+	static void* const cBranchTable[]{
+		&&BRANCH_0x0, &&BRANCH_0x1, &&BRANCH_0x2, &&BRANCH_0x3,
+		&&BRANCH_0x4, &&BRANCH_0x5, &&BRANCH_0x6, &&BRANCH_0x7,
+		&&BRANCH_0x8, &&BRANCH_0x9, &&BRANCH_0xA, &&BRANCH_0xB,
+		&&BRANCH_0xC, &&BRANCH_0xD, &&BRANCH_0xE, &&BRANCH_0xF,
+	};
+#else
+	#define BRANCH(n) case n
+#endif
+
 	auto cycleCount{ 0 };
 	for (; cycleCount < mCyclesPerFrame; ++cycleCount) {
 		auto HI = readMemory(mProgCounter++);
@@ -55,8 +68,13 @@ void MEGACORE::instructionLoop() {
 		const auto Y{ LO >>  4 };
 		const auto N{ LO & 0xF };
 
+	#ifdef CUBECHIP_THREADED_DISPATCH
+		goto *cBranchTable[HI >> 4];
+		{
+	#else
 		switch (HI >> 4) {
-			case 0x0: switch (NN0()) {
+	#endif
+			BRANCH(0x0): switch (NN0()) {
 				case 0x00B0:
 				case 0x00D0:
 					instruction_00DN_XO(N);
@@ -193,20 +211,20 @@ void MEGACORE::instructionLoop() {
 						[[unlikely]] default: triggerOpcodeError(mInstruction);
 					}
 				}
-			} break;
-			case 0x1:
+			} continue;
+			BRANCH(0x1):
 				instruction_1NNN_C8();
-				break;
-			case 0x2:
+				continue;
+			BRANCH(0x2):
 				instruction_2NNN_C8();
-				break;
-			case 0x3:
+				continue;
+			BRANCH(0x3):
 				instruction_3xNN_C8(X, LO);
-				break;
-			case 0x4:
+				continue;
+			BRANCH(0x4):
 				instruction_4xNN_C8(X, LO);
-				break;
-			case 0x5: switch (N) {
+				continue;
+			BRANCH(0x5): switch (N) {
 				case 0x0:
 					instruction_5xy0_C8(X, Y);
 					break;
@@ -241,14 +259,14 @@ void MEGACORE::instructionLoop() {
 					instruction_5xy4_XO(X, Y);
 				} break;
 				[[unlikely]] default: triggerOpcodeError(mInstruction);
-			} break;
-			case 0x6:
+			} continue;
+			BRANCH(0x6):
 				instruction_6xNN_C8(X, LO);
-				break;
-			case 0x7:
+				continue;
+			BRANCH(0x7):
 				instruction_7xNN_C8(X, LO);
-				break;
-			case 0x8: switch (N) {
+				continue;
+			BRANCH(0x8): switch (N) {
 				case 0x0:
 					instruction_8xy0_C8(X, Y);
 					break;
@@ -286,17 +304,17 @@ void MEGACORE::instructionLoop() {
 					instruction_8xyF_HW(X, Y);
 				} break;
 				[[unlikely]] default: triggerOpcodeError(mInstruction);
-			} break;
-			case 0x9: switch (N) {
+			} continue;
+			BRANCH(0x9): switch (N) {
 				case 0x0:
 					instruction_9xy0_C8(X, Y);
 					break;
 				[[unlikely]] default: triggerOpcodeError(mInstruction);
-			} break;
-			case 0xA:
+			} continue;
+			BRANCH(0xA):
 				instruction_ANNN_C8();
-				break;
-			case 0xB: {
+				continue;
+			BRANCH(0xB): {
 				if (State.chip8E_rom) {
 					switch (X) {
 						case 0xB:
@@ -317,14 +335,14 @@ void MEGACORE::instructionLoop() {
 				} else {
 					instruction_BxNN_C8(X);
 				}
-			} break;
-			case 0xC:
+			} continue;
+			BRANCH(0xC):
 				instruction_CxNN_C8(X, LO);
-				break;
-			case 0xD:
+				continue;
+			BRANCH(0xD):
 				instruction_DxyN_C8(X, Y, N);
-				break;
-			case 0xE: switch (LO) {
+				continue;
+			BRANCH(0xE): switch (LO) {
 				case 0x9E:
 					instruction_Ex9E_C8(X);
 					break;
@@ -338,8 +356,8 @@ void MEGACORE::instructionLoop() {
 					instruction_ExF5_8X(X);
 					break;
 				[[unlikely]] default: triggerOpcodeError(mInstruction);
-			} break;
-			case 0xF: switch (NNN()) {
+			} continue;
+			BRANCH(0xF): switch (NNN()) {
 				case 0x000:
 					instruction_F000_XO();
 					break;
@@ -428,10 +446,12 @@ void MEGACORE::instructionLoop() {
 						break;
 					[[unlikely]] default: triggerOpcodeError(mInstruction);
 				} break;
-			} break;
+			} continue;
 		}
 	}
 	mTotalCycles += cycleCount;
+
+	#undef BRANCH
 }
 
 std::string MEGACORE::hexOpcode(const u32 opcode) const {
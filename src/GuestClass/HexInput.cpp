@@ -32,18 +32,45 @@ void HexInput::loadCustomBinds(std::vector<KeyInfo>&& binds) {
 void HexInput::updateKeyStates() noexcept {
 	if (!mCustomBinds.size()) { return; }
 
-	mKeysPrev = mKeysCurr;
-	mKeysCurr = 0;
+	Uint32 keyStates{};
 
-	for (const auto& mapping : mCustomBinds) {
-		if (bic::kb.areAnyHeld(mapping.key, mapping.alt)) {
-			mKeysCurr |= 1 << mapping.idx;
+	if (mKeySource) {
+		for (const auto& mapping : mCustomBinds) {
+			if (mKeySource[mapping.key] || mKeySource[mapping.alt]) {
+				keyStates |= 1 << mapping.idx;
+			}
+		}
+	} else {
+		for (const auto& mapping : mCustomBinds) {
+			if (bic::kb.areAnyHeld(mapping.key, mapping.alt)) {
+				keyStates |= 1 << mapping.idx;
+			}
 		}
 	}
 
+	updateKeyStates(keyStates);
+}
+
+void HexInput::updateKeyStates(const Uint32 keyStates) noexcept {
+	mKeysPrev = mKeysCurr;
+	mKeysCurr = keyStates;
+
 	mKeysLoop &= mKeysLock &= ~(mKeysPrev ^ mKeysCurr);
 }
 
+HexInput::KeyStates HexInput::saveKeyStates() const noexcept {
+	return { mTickLast, mTickSpan, mKeysCurr, mKeysPrev, mKeysLock, mKeysLoop };
+}
+
+void HexInput::loadKeyStates(const KeyStates& states) noexcept {
+	mTickLast = states.tickLast;
+	mTickSpan = states.tickSpan;
+	mKeysCurr = states.keysCurr;
+	mKeysPrev = states.keysPrev;
+	mKeysLock = states.keysLock;
+	mKeysLoop = states.keysLoop;
+}
+
 bool HexInput::keyPressed(Uint8& returnKey, const Uint32 tickCount) noexcept {
 	if (!mCustomBinds.size()) { return false; }
 
@@ -18,6 +18,8 @@ class HexInput final {
 
 	std::vector<KeyInfo> mCustomBinds;
 
+	const Uint8* mKeySource{}; // keyboard snapshot to read, live state if null
+
 	Uint32 mTickLast{};
 	Uint32 mTickSpan{};
 
@@ -27,12 +29,26 @@ class HexInput final {
 	Uint32 mKeysLoop{}; // bitfield of keys repeating input on Fx0A
 
 public:
+	// Key bitfields and repeat timing, the part of the input kept in save states
+	struct KeyStates final {
+		Uint32 tickLast, tickSpan;
+		Uint32 keysCurr, keysPrev;
+		Uint32 keysLock, keysLoop;
+	};
+
 	explicit HexInput();
 
 	void loadPresetBinds();
 	void loadCustomBinds(std::vector<KeyInfo>&& bindings);
 
+	// Read keys from given snapshot indexed by scancode instead of the live state
+	void useKeySource(const Uint8* keys) noexcept { mKeySource = keys; }
+
 	void updateKeyStates() noexcept;
+	void updateKeyStates(Uint32 keyStates) noexcept;
+
+	KeyStates saveKeyStates() const noexcept;
+	void      loadKeyStates(const KeyStates&) noexcept;
 
 	bool keyPressed(Uint8& returnKey, Uint32 tickCount) noexcept;
 	bool keyHeld_P1(Uint32 keyIndex) const noexcept;
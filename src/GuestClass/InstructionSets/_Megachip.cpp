@@ -6,9 +6,9 @@
 
 #include <cmath>
 #include <algorithm>
-#include <execution>
 
 #include "../../HostClass/BasicVideoSpec.hpp"
+#include "../../Assistants/JobSystem.hpp"
 
 #include "Interface.hpp"
 #include "../Guest.hpp"
@@ -99,13 +99,21 @@ void FunctionsForMegachip::blendBuffersToTexture(
 	const std::span<const u32> srcColors,
 	const std::span<const u32> dstColors
 ) {
-	std::transform(
-		std::execution::par_unseq,
-		srcColors.begin(), srcColors.end(),
-		dstColors.begin(),
-		vm.BVS.lockTexture(),
-		[this](const u32 src, const u32 dst) {
-			return blendPixel(src, dst, vm.Texture.alpha, blendAlgo);
+	static constexpr usz cBlendRows{ 32 };
+
+	auto* const texture{ vm.BVS.lockTexture() };
+	const auto rowSize{ static_cast<usz>(vm.Trait.W) };
+	bjs::jobs.parallel_for(0, srcColors.size() / rowSize, cBlendRows,
+		[&](const usz rowBegin, const usz rowEnd) {
+			std::transform(
+				srcColors.begin() + rowBegin * rowSize,
+				srcColors.begin() + rowEnd   * rowSize,
+				dstColors.begin() + rowBegin * rowSize,
+				texture + rowBegin * rowSize,
+				[this](const u32 src, const u32 dst) {
+					return blendPixel(src, dst, vm.Texture.alpha, blendAlgo);
+				}
+			);
 		}
 	);
 	vm.BVS.unlockTexture();
@@ -0,0 +1,71 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <algorithm>
+
+#include "PristineCache.hpp"
+#include "EmuCores/EmuCores.hpp"
+
+#include "../HostClass/HomeDirManager.hpp"
+
+PristineCache::~PristineCache() noexcept = default;
+PristineCache::PristineCache(const usz capacity) noexcept
+	: mCapacity{ std::max<usz>(capacity, 1) }
+{}
+
+void PristineCache::park(std::unique_ptr<EmuCores>&& core) {
+	if (!core) { return; }
+
+	for (auto& entry : mEntries) {
+		if (entry.owner == core.get() && !entry.core) {
+			entry.core = std::move(core);
+			return;
+		}
+	}
+	core.reset();
+}
+
+std::unique_ptr<EmuCores> PristineCache::fetch(
+	HomeDirManager& HDM,
+	BasicVideoSpec& BVS,
+	BasicAudioSpec& BAS
+) {
+	const auto type{ GameFileChecker::getCore() };
+
+	const auto found{ std::find_if(mEntries.begin(), mEntries.end(),
+		[&](const Entry& entry) noexcept {
+			return entry.core && entry.type == type && entry.sha1 == HDM.sha1;
+		}
+	) };
+
+	if (found != mEntries.end()) {
+		std::rotate(mEntries.begin(), found, found + 1);
+		auto& entry{ mEntries.front() };
+
+		entry.core->initPlatform();
+		if (entry.core->loadState(entry.state)) {
+			return std::move(entry.core);
+		}
+		mEntries.erase(mEntries.begin());
+	}
+
+	auto core{ GameFileChecker::initializeCore(HDM, BVS, BAS) };
+	if (!core || !core->stateSize()) { return core; }
+
+	Entry entry{
+		.sha1  = HDM.sha1,
+		.type  = type,
+		.owner = core.get(),
+		.state = std::vector<u8>(core->stateSize()),
+	};
+	if (!core->saveState(entry.state)) { return core; }
+
+	mEntries.insert(mEntries.begin(), std::move(entry));
+	if (mEntries.size() > mCapacity) {
+		mEntries.resize(mCapacity);
+	}
+	return core;
+}
@@ -0,0 +1,51 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Types.hpp"
+#include "GameFileChecker.hpp"
+
+/*
+	Recently run cores kept alive by the SHA1 of their rom, together with
+	a save state taken right after construction. Resetting or returning to
+	one of those roms loads that state into the parked core instead of
+	building a new one, so no rom file is read again. Cores without save
+	states are never parked.
+*/
+
+class PristineCache final {
+	struct Entry final {
+		std::string  sha1{};
+		GameCoreType type{};
+
+		std::unique_ptr<EmuCores> core{}; // empty while the core is running
+		const EmuCores* owner{};          // the core, parked or not
+
+		std::vector<u8> state{};
+	};
+
+	usz mCapacity{};
+	std::vector<Entry> mEntries{}; // most recently used first
+
+public:
+	explicit PristineCache(usz capacity) noexcept;
+	~PristineCache() noexcept;
+
+	// Take back a core that stopped running, dropped if it is not cached
+	void park(std::unique_ptr<EmuCores>&& core);
+
+	// Core for the rom in HDM, a parked one reset to its pristine state if any
+	std::unique_ptr<EmuCores> fetch(
+		HomeDirManager&,
+		BasicVideoSpec&,
+		BasicAudioSpec&
+	);
+};
@@ -0,0 +1,193 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "RewindBuffer.hpp"
+#include "EmuCores/EmuCores.hpp"
+
+/*==================================================================*/
+	#pragma region Delta Packing
+/*==================================================================*/
+
+/*
+	A delta is a list of tokens, each a varint count of unchanged bytes,
+	a varint count of changed bytes, then the changed bytes XORed with
+	their old value. Changed runs only end at 8 unchanged bytes in a row,
+	so a token never packs larger than the bytes it covers, save for the
+	first one. Only the given ranges are compared, bytes outside of them
+	count as unchanged, as do those at the end which are left out entirely.
+*/
+
+static u64 load64(const u8* ptr) noexcept {
+	u64 value; std::memcpy(&value, ptr, sizeof(value));
+	return value;
+}
+
+static u8* writeVarint(u8* out, usz value) noexcept {
+	while (value >= 0x80) {
+		*out++ = static_cast<u8>(value | 0x80);
+		value >>= 7;
+	}
+	*out++ = static_cast<u8>(value);
+	return out;
+}
+
+static const u8* readVarint(const u8* in, usz& value) noexcept {
+	value = 0;
+	for (auto shift{ 0 }; ; shift += 7) {
+		const auto byte{ *in++ };
+		value |= static_cast<usz>(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) { return in; }
+	}
+}
+
+usz RewindBuffer::packDelta(
+	const u8* fresh, const u8* state, const Ranges& ranges, u8* out
+) noexcept {
+	const auto* const outBegin{ out };
+	usz last{}; // end of the previous changed run
+
+	for (const auto& [offset, length] : ranges) {
+		const auto end{ offset + length };
+
+		for (auto pos{ offset }; pos < end;) {
+			while (pos + 8 <= end && load64(fresh + pos) == load64(state + pos)) { pos += 8; }
+			while (pos < end && fresh[pos] == state[pos]) { ++pos; }
+			if (pos == end) { break; }
+
+			const auto diff{ pos };
+			while (++pos < end) {
+				if (pos + 8 <= end) {
+					if (load64(fresh + pos) == load64(state + pos)) { break; }
+				} else if (!std::memcmp(fresh + pos, state + pos, end - pos)) { break; }
+			}
+
+			out = writeVarint(out, diff - last);
+			out = writeVarint(out, pos - diff);
+			for (auto i{ diff }; i < pos; ++i) {
+				*out++ = fresh[i] ^ state[i];
+			}
+			last = pos;
+		}
+	}
+	return static_cast<usz>(out - outBegin);
+}
+
+void RewindBuffer::applyDelta(const u8* in, const usz size, u8* state) noexcept {
+	const auto* const inEnd{ in + size };
+
+	while (in < inEnd) {
+		usz same, diff;
+		in = readVarint(in, same);
+		in = readVarint(in, diff);
+
+		state += same;
+		for (usz i{}; i < diff; ++i) {
+			*state++ ^= *in++;
+		}
+	}
+}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
+
+/*==================================================================*/
+	#pragma region Frame Ring
+/*==================================================================*/
+
+void RewindBuffer::reset(const usz stateSize, const usz frames, const usz bytes) {
+	clear();
+	if (!stateSize) {
+		mState = {}; mFresh = {}; mDelta = {};
+		mBytes = {}; mEntries = {};
+		return;
+	}
+
+	// contents are never read before being written, resetting to the same sizes is free
+	mState.resize(stateSize);
+	mFresh.resize(stateSize);
+	mDelta.resize(stateSize + 16);
+
+	mBytes.resize(bytes);
+	mEntries.resize(std::max<usz>(frames, 1));
+}
+
+void RewindBuffer::dropOldest() noexcept {
+	mUsed -= mEntries[mFirst].size;
+	if (++mFirst == mEntries.size()) { mFirst = 0; }
+	--mCount;
+}
+
+void RewindBuffer::capture(EmuCores& core) {
+	if (!enabled()) { return; }
+
+	const auto since{ mStamp };
+	mStamp = core.saveStateSince(mFresh, since, &mRanges);
+	if (!mStamp) { clear(); return; }
+
+	if (!mPrimed) {
+		mState = mFresh;
+		mPrimed = true;
+		return;
+	}
+
+	// the delta leads back from the fresh frame to the one kept so far
+	const auto size{ packDelta(mFresh.data(), mState.data(), mRanges, mDelta.data()) };
+	for (const auto& [offset, length] : mRanges) {
+		std::copy_n(mFresh.data() + offset, length, mState.data() + offset);
+	}
+
+	if (size > mBytes.size()) {
+		// a change too large to keep, the frames before it are out of reach
+		mCount = mHead = mUsed = 0;
+		return;
+	}
+
+	if (mHead + size > mBytes.size()) {
+		// frames past the head are the oldest, wrapping would leave them out of order
+		while (mCount && mEntries[mFirst].offset >= mHead) { dropOldest(); }
+		mHead = 0;
+	}
+
+	while (mCount) {
+		const auto& oldest{ mEntries[mFirst] };
+		if (mCount < mEntries.size()
+			&& (oldest.offset >= mHead + size || oldest.offset + oldest.size <= mHead)
+		) { break; }
+		dropOldest();
+	}
+
+	auto index{ mFirst + mCount };
+	if (index >= mEntries.size()) { index -= mEntries.size(); }
+	mEntries[index] = { static_cast<u32>(mHead), static_cast<u32>(size), since };
+
+	std::copy_n(mDelta.data(), size, mBytes.data() + mHead);
+	mHead += size;
+	mUsed += size;
+	++mCount;
+}
+
+bool RewindBuffer::rewind(EmuCores& core) {
+	if (!mCount) { return false; }
+
+	auto index{ mFirst + --mCount };
+	if (index >= mEntries.size()) { index -= mEntries.size(); }
+	const auto& newest{ mEntries[index] };
+
+	applyDelta(mBytes.data() + newest.offset, newest.size, mState.data());
+	mHead  = newest.offset;
+	mUsed -= newest.size;
+
+	// the core is at a later frame, it can only differ in pages written since
+	return core.loadStateSince(mState, newest.stamp);
+}
+
+/*ΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛΛ*/
+	#pragma endregion
+/*VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV*/
@@ -0,0 +1,70 @@
+/*
+	This Source Code Form is subject to the terms of the Mozilla Public
+	License, v. 2.0. If a copy of the MPL was not distributed with this
+	file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "../Types.hpp"
+
+class EmuCores;
+
+/*
+	Ring of per-frame save states for rewinding. Only the latest state is
+	kept whole; each frame before it is stored as the XOR delta to the
+	frame after, packed as runs of unchanged bytes and changed bytes. A
+	rewind step XORs the newest delta back into the kept state and loads
+	it, and the oldest frames are dropped once either ring is full. Only the
+	parts of a state saved anew since the last frame are ever compared.
+*/
+
+class RewindBuffer final {
+	using Ranges = std::vector<std::pair<usz, usz>>;
+
+	struct Entry final {
+		u32 offset;
+		u32 size;
+		u32 stamp; // of the frame the delta leads back to
+	};
+
+	std::vector<u8> mState{}; // state of the newest captured frame
+	std::vector<u8> mFresh{}; // state being captured, kept saved since mStamp
+	std::vector<u8> mDelta{}; // delta being packed, sized for the worst case
+	Ranges          mRanges{}; // parts of mFresh saved anew by the last capture
+
+	u32 mStamp{}; // of the newest captured frame, 0 before the first
+
+	std::vector<u8>    mBytes{};   // packed deltas, oldest ones overwritten
+	std::vector<Entry> mEntries{}; // one per rewindable frame, oldest first from mFirst
+
+	usz mFirst{}; // index of the oldest entry
+	usz mCount{};
+	usz mHead{};  // where the next packed delta goes in mBytes
+	usz mUsed{};  // bytes of mBytes held by entries
+
+	bool mPrimed{}; // mState holds a frame to delta against
+
+	static usz  packDelta(const u8* fresh, const u8* state, const Ranges& ranges, u8* out) noexcept;
+	static void applyDelta(const u8* in, usz size, u8* state) noexcept;
+
+	void dropOldest() noexcept;
+
+public:
+	// Reserve room for given frames of given state size within given bytes
+	void reset(usz stateSize, usz frames, usz bytes);
+	void clear() noexcept { mCount = mHead = mUsed = 0; mStamp = 0; mPrimed = false; }
+
+	[[nodiscard]] bool enabled() const noexcept { return !mState.empty(); }
+
+	// Add the current frame of the core to the ring
+	void capture(EmuCores&);
+	// Step the core back one captured frame, false if there are none left
+	bool rewind(EmuCores&);
+
+	usz getFrames() const noexcept { return mCount; }
+	usz getBytes()  const noexcept { return mUsed; }
+};
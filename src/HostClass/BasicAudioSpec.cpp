@@ -6,31 +6,131 @@
 
 #include "BasicAudioSpec.hpp"
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
 
 static constexpr s32 VOL_MAX{ 255 };
 static constexpr s32 VOL_MIN{   0 };
 
-BasicAudioSpec::BasicAudioSpec()
+BasicAudioSpec::BasicAudioSpec(const bool noDevice)
 	: audiospec{ SDL_AUDIO_S16, 1, outFrequency }
 {
-	SDL_InitSubSystem(SDL_INIT_AUDIO);
 	setVolume(VOL_MAX);
+	if (noDevice) { return; }
+
+	SDL_InitSubSystem(SDL_INIT_AUDIO);
 
 	stream = SDL_OpenAudioDeviceStream(
 		SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK,
-		&audiospec, nullptr, nullptr
+		&audiospec, audioCallback, this
 	);
 	device = SDL_GetAudioStreamDevice(stream);
 	SDL_ResumeAudioDevice(device);
 }
 
 BasicAudioSpec::~BasicAudioSpec() {
-	if (stream) SDL_DestroyAudioStream(stream);
+	if (!stream) { return; }
+	SDL_DestroyAudioStream(stream);
 	SDL_QuitSubSystem(SDL_INIT_AUDIO);
 }
 
 void BasicAudioSpec::pushAudioData(const void* const data, const usz length) {
-	SDL_PutAudioStreamData(stream, data, static_cast<s32>(length * 2));
+	if (!stream) { return; }
+
+	if (const auto rate{ speed.load(std::memory_order_relaxed) }; rate > 1.0f) {
+		switch (fastAudio.load(std::memory_order_relaxed)) {
+			case FastAudio::DROP:
+				return;
+
+			case FastAudio::DECIMATE:
+				if (pushCount++ % static_cast<u32>(std::lround(rate))) { return; }
+				break;
+
+			case FastAudio::PITCH:
+				break;
+		}
+		// whatever the device cannot keep up with is dropped rather than queued
+		if (samples.size() > fastQueueLimit) { return; }
+	}
+	// a full ring drops the rest, the rate control will have it drain faster
+	samples.pushRange({ static_cast<const s16*>(data), length });
+}
+
+void BasicAudioSpec::audioCallback(
+	void* const userdata, SDL_AudioStream*,
+	const int additional_amount, int
+) {
+	static_cast<BasicAudioSpec*>(userdata)->drainSamples(additional_amount / 2);
+}
+
+void BasicAudioSpec::drainSamples(s32 wanted) {
+	if (retuneAudio.exchange(false, std::memory_order_acquire)) {
+		audioTuning.applyToThisThread("audio");
+	}
+
+	const auto depth{ static_cast<f32>(samples.size()) };
+	if (depth >= targetDepth) { primed = true; }
+
+	const auto adjust{ std::clamp(
+		1.0f + maxRateAdjust * (depth - targetDepth) / targetDepth,
+		1.0f - maxRateAdjust, 1.0f + maxRateAdjust
+	) };
+	rateAdjust.store(adjust, std::memory_order_relaxed);
+
+	const auto pitch{ getFastAudio() == FastAudio::PITCH
+		? std::min(speed.load(std::memory_order_relaxed), 100.0f) : 1.0f };
+	SDL_SetAudioStreamFrequencyRatio(stream, pitch * adjust);
+
+	std::array<s16, 1024> chunk;
+	bool ranDry{};
+
+	while (wanted > 0) {
+		const auto count{ std::min<usz>(static_cast<usz>(wanted), chunk.size()) };
+		const auto taken{ samples.popRange({ chunk.data(), count }) };
+		if (taken < count) {
+			std::fill(chunk.begin() + taken, chunk.begin() + count, s16{});
+			ranDry = true;
+		}
+		SDL_PutAudioStreamData(stream, chunk.data(), static_cast<s32>(count * 2));
+		wanted -= static_cast<s32>(count);
+	}
+
+	// running dry only counts once the ring had been filled, not while idle
+	if (ranDry && primed) {
+		underruns.fetch_add(1, std::memory_order_relaxed);
+		primed = false;
+	}
+}
+
+void BasicAudioSpec::setSpeed(const f32 value) noexcept {
+	// the callback picks it up the next time it drains the ring
+	speed.store(std::max(value, 1.0f), std::memory_order_relaxed);
+}
+
+void BasicAudioSpec::tuneAudioThread(const ThreadTuning& tuning) noexcept {
+	if (!stream || tuning.isDefault()) { return; }
+	audioTuning = tuning;
+	retuneAudio.store(true, std::memory_order_release);
+}
+
+BasicAudioSpec::Stats BasicAudioSpec::getStats() const noexcept {
+	return {
+		static_cast<u32>(samples.size()),
+		underruns.load(std::memory_order_relaxed),
+		rateAdjust.load(std::memory_order_relaxed),
+	};
+}
+
+BasicAudioSpec::FastAudio BasicAudioSpec::cycleFastAudio() noexcept {
+	auto policy{ getFastAudio() };
+	switch (policy) {
+		case FastAudio::DROP:     policy = FastAudio::PITCH;    break;
+		case FastAudio::PITCH:    policy = FastAudio::DECIMATE; break;
+		case FastAudio::DECIMATE: policy = FastAudio::DROP;     break;
+	}
+	fastAudio.store(policy, std::memory_order_relaxed);
+	return policy;
 }
 
 void BasicAudioSpec::setVolume(const s32 value) noexcept {
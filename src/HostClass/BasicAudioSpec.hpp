@@ -8,22 +8,74 @@
 
 #include <SDL3/SDL.h>
 
+#include <atomic>
+
 #include "../Types.hpp"
+#include "../Assistants/SPSCQueue.hpp"
+#include "../Assistants/ThreadTuning.hpp"
+
+/*
+	Cores push samples into a lock-free ring that the audio device drains
+	from a callback, on its own thread. Each time it does, the rate the
+	device plays the ring at is nudged by up to half a percent so that the
+	ring stays near its target depth, which absorbs jitter in the pace the
+	frames are run at without underruns or latency growing over time.
+*/
 
 class BasicAudioSpec final {
 	static constexpr
 	u32 outFrequency{ 48'000 };
+	static constexpr
+	u32 fastQueueLimit{ outFrequency / 10 }; // samples queued at most while sped up
+	static constexpr
+	u32 targetDepth{ outFrequency / 25 };    // samples the rate control aims to keep queued
+	static constexpr
+	f32 maxRateAdjust{ 0.005f };
 
 	s16 volume{};
 	s16 amplitude{};
 
+public:
+	// What happens to audio while the guest runs faster than real time
+	enum class FastAudio {
+		DROP,     // silence
+		PITCH,    // played faster, and higher
+		DECIMATE, // played at pace, only every Nth frame of it
+	};
+
+	struct Stats final {
+		u32 queued;    // samples waiting in the ring
+		u32 underruns; // device callbacks the ring ran dry in
+		f32 rate;      // last rate adjustment, 1 being none
+	};
+
+private:
+	// set by the host while the guest thread pushes audio
+	std::atomic<FastAudio> fastAudio{ FastAudio::PITCH };
+	std::atomic<f32>       speed{ 1.0f };
+
+	u32 pushCount{};
+
+	SPSCQueue<s16, 16384>
+		samples{};
+
+	ThreadTuning      audioTuning{};
+	std::atomic<bool> retuneAudio{}; // apply audioTuning on the next callback
+
+	std::atomic<u32> underruns{};
+	bool primed{}; // ring reached its target depth since it last ran dry
+	std::atomic<f32> rateAdjust{ 1.0f };
+
 private:
 	SDL_AudioSpec     audiospec{};
 	SDL_AudioDeviceID device{};
 	SDL_AudioStream*  stream{};
 
+	static void audioCallback(void*, SDL_AudioStream*, int, int);
+	void drainSamples(s32);
+
 public:
-	explicit BasicAudioSpec();
+	explicit BasicAudioSpec(const bool noDevice = false);
 	~BasicAudioSpec();
 
 	void pushAudioData(const void*, usz);
@@ -35,4 +87,15 @@ public:
 
 	void setVolume(s32) noexcept;
 	void changeVolume(s32) noexcept;
+
+	// Speed of the guest relative to real time, above 1 audio follows the policy
+	void setSpeed(f32) noexcept;
+	auto getFastAudio() const noexcept { return fastAudio.load(std::memory_order_relaxed); }
+	FastAudio cycleFastAudio() noexcept;
+
+	[[nodiscard]]
+	Stats getStats() const noexcept;
+
+	// Pinning and scheduling of the device's thread, applied from its next callback
+	void tuneAudioThread(const ThreadTuning&) noexcept;
 };
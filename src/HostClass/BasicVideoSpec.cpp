@@ -9,9 +9,11 @@
 
 #include "BasicVideoSpec.hpp"
 
-BasicVideoSpec::BasicVideoSpec()
-	: enableBuzzGlow{ true }
+BasicVideoSpec::BasicVideoSpec(const bool noWindow)
+	: headless{ noWindow }
+	, enableBuzzGlow{ true }
 {
+	if (headless) { return; }
 	try {
 		SDL_InitSubSystem(SDL_INIT_VIDEO);
 		createWindow(0, 0);
@@ -25,10 +27,11 @@ BasicVideoSpec::BasicVideoSpec()
 }
 
 BasicVideoSpec::~BasicVideoSpec() {
+	quitOverlay();
 	quitTexture();
 	quitRenderer();
 	quitWindow();
-	SDL_QuitSubSystem(SDL_INIT_VIDEO);
+	if (!headless) { SDL_QuitSubSystem(SDL_INIT_VIDEO); }
 }
 
 void BasicVideoSpec::createWindow(const s32 window_W, const s32 window_H) {
@@ -49,30 +52,33 @@ void BasicVideoSpec::createRenderer() {
 	if (!renderer) {
 		throw std::runtime_error(SDL_GetError());
 	}
+
+	// cores draw ARGB8888, which XRGB8888 shares the layout of; stick to whichever
+	// of the two the renderer takes as is so SDL won't convert every upload
+	const auto* formats{ static_cast<const PixelFormat*>(SDL_GetPointerProperty(
+		SDL_GetRendererProperties(renderer),
+		SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER, nullptr
+	)) };
+
+	textureFormat = SDL_PIXELFORMAT_ARGB8888;
+	for (auto* format{ formats }; format && *format != SDL_PIXELFORMAT_UNKNOWN; ++format) {
+		if (*format == SDL_PIXELFORMAT_ARGB8888) { textureFormat = *format; break; }
+		if (*format == SDL_PIXELFORMAT_XRGB8888) { textureFormat = *format; }
+	}
 }
 
 void BasicVideoSpec::createTexture(s32 texture_W, s32 texture_H) {
-	quitTexture();
-
 	texture_W = std::max<s32>(std::abs(texture_W), 1);
 	texture_H = std::max<s32>(std::abs(texture_H), 1);
 
-	texture = SDL_CreateTexture(
-		renderer,
-		SDL_PIXELFORMAT_ARGB8888,
-		SDL_TEXTUREACCESS_STREAMING,
-		texture_W, texture_H
-	);
-
-	if (!texture) {
-		throw std::runtime_error(SDL_GetError());
-	} else {
-		SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
-		ppitch = texture_W * 4;
-	}
+	staged.pixels.assign(static_cast<usz>(texture_W * texture_H), 0);
+	staged.texture_W = texture_W;
+	staged.texture_H = texture_H;
+	stagedRows = { 0, texture_H - 1 };
 }
 
 void BasicVideoSpec::changeTitle(const std::string& name) {
+	if (headless) { return; }
 	static constexpr char emuVersion[]{ "[06.06.24]" };
 	std::string windowTitle{ "CubeChip :: " + name };
 	SDL_SetWindowTitle(window, windowTitle.c_str());
@@ -93,40 +99,127 @@ bool BasicVideoSpec::showErrorBox(std::string_view message, std::string_view tit
 }
 
 void BasicVideoSpec::raiseWindow() {
+	if (headless) { return; }
 	SDL_RaiseWindow(window);
 }
 
 void BasicVideoSpec::resetWindow() {
+	if (headless) { return; }
 	SDL_SetWindowSize(window, 640, 480);
 	changeTitle("Waiting for file...");
 	quitTexture();
+	frames.update(); // leave behind whatever the last core still handed over
+	aspectW = aspectH = aspectP = 0;
+	presentPending = true;
 	renderPresent();
 }
 
 u32* BasicVideoSpec::lockTexture() {
-	void* pixel_ptr{};
-	SDL_LockTexture(
-		texture, nullptr,
-		&pixel_ptr,
-		&ppitch
-	);
-	return static_cast<u32*>(pixel_ptr);
+	stagedRows = { 0, staged.texture_H - 1 };
+	return staged.pixels.data();
+}
+u32* BasicVideoSpec::lockTextureRows(s32 first, s32 last) {
+	first = std::max(first, 0);
+	last  = std::min(last, staged.texture_H - 1);
+	stagedRows.merge({ first, last });
+	return staged.pixels.data() + first * staged.texture_W;
 }
 void BasicVideoSpec::unlockTexture() {
-	SDL_UnlockTexture(texture);
+	return;
+}
+
+void BasicVideoSpec::publishFrame() {
+	if (headless) { return; }
+	staged.changed[++staged.serial % cRowHistory] = std::exchange(stagedRows, {});
+	frames.back() = staged;
+	frames.publish();
+}
+
+BasicVideoSpec::RowSpan BasicVideoSpec::Frame::changedSince(const u32 since) const noexcept {
+	if (serial - since >= cRowHistory) { return { 0, texture_H - 1 }; }
+
+	RowSpan rows{};
+	for (auto idx{ since + 1 }; idx != serial + 1; ++idx)
+		{ rows.merge(changed[idx % cRowHistory]); }
+	return rows;
 }
 
 void BasicVideoSpec::setTextureAlpha(const usz alpha) {
-	SDL_SetTextureAlphaMod(texture, static_cast<u8>(alpha));
+	staged.alpha = static_cast<u8>(alpha);
 }
 
 void BasicVideoSpec::setAspectRatio(
 	const s32 texture_W,
 	const s32 texture_H,
 	const s32 padding_S
+) {
+	staged.aspect_W = texture_W;
+	staged.aspect_H = texture_H;
+	staged.aspect_P = padding_S;
+}
+
+void BasicVideoSpec::uploadFrame(const Frame& frame) {
+	if (frame.pixels.empty()) { return; }
+
+	auto rows{ frame.changedSince(uploadedSerial) };
+	uploadedSerial = frame.serial;
+
+	if (!texture || frame.texture_W != textureW || frame.texture_H != textureH) {
+		quitTexture();
+		rows = { 0, frame.texture_H - 1 };
+
+		texture = SDL_CreateTexture(
+			renderer,
+			textureFormat,
+			SDL_TEXTUREACCESS_STREAMING,
+			frame.texture_W, frame.texture_H
+		);
+
+		if (!texture) {
+			throw std::runtime_error(SDL_GetError());
+		} else {
+			SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+			textureW = frame.texture_W;
+			textureH = frame.texture_H;
+		}
+	}
+
+	if (frame.aspect_W != aspectW || frame.aspect_H != aspectH || frame.aspect_P != aspectP) {
+		applyAspectRatio(frame.aspect_W, frame.aspect_H, frame.aspect_P);
+		presentPending = true;
+	}
+
+	if (frameGameColor    != frame.backColor
+	||  frameFullColor[0] != frame.frameColor[0]
+	||  frameFullColor[1] != frame.frameColor[1]
+	||  textureAlpha      != frame.alpha
+	) {
+		frameGameColor    = frame.backColor;
+		frameFullColor[0] = frame.frameColor[0];
+		frameFullColor[1] = frame.frameColor[1];
+		textureAlpha      = frame.alpha;
+		presentPending    = true;
+	}
+
+	SDL_SetTextureAlphaMod(texture, frame.alpha);
+	if (rows.empty()) { return; }
+	presentPending = true;
+
+	const SDL_Rect area{ 0, rows.first, textureW, rows.last - rows.first + 1 };
+	SDL_UpdateTexture(texture, &area, frame.pixels.data() + rows.first * textureW, textureW * 4);
+}
+
+void BasicVideoSpec::applyAspectRatio(
+	const s32 texture_W,
+	const s32 texture_H,
+	const s32 padding_S
 ) {
 	const auto padding_A{ std::abs(padding_S) };
 
+	aspectW = texture_W;
+	aspectH = texture_H;
+	aspectP = padding_S;
+
 	perimeterWidth = padding_A;
 	enableScanLine = padding_A == padding_S;
 
@@ -149,6 +242,50 @@ void BasicVideoSpec::setAspectRatio(
 		SDL_LOGICAL_PRESENTATION_INTEGER_SCALE,
 		SDL_SCALEMODE_NEAREST
 	);
+
+	buildOverlay();
+}
+
+void BasicVideoSpec::buildOverlay() {
+	quitOverlay();
+
+	const auto W{ static_cast<s32>(frameFull.w) };
+	const auto H{ static_cast<s32>(frameFull.h) };
+	if (W <= 0 || H <= 0) { return; }
+
+	// the overlay is drawn in logical units like the rest, so only the aspect
+	// changes it, the frame multiplier merely scales the whole presentation
+	static constexpr u32 borderPixel{ 0xFFFFFFFF };
+	static constexpr u32 borderLined{ 0xFFDFDFDF }; // border under a scanline, 32/255 darker
+	static constexpr u32 scanLine   { 0x20000000 };
+
+	std::vector<u32> pixels(static_cast<usz>(W * H));
+	for (auto Y{ 0 }; Y < H; ++Y) {
+		const bool lined{ enableScanLine && perimeterWidth && Y % perimeterWidth == 0 };
+		const bool edgeY{ Y < perimeterWidth || Y >= H - perimeterWidth };
+
+		for (auto X{ 0 }; X < W; ++X) {
+			const bool border{ edgeY || X < perimeterWidth || X >= W - perimeterWidth };
+			pixels[Y * W + X] = border
+				? (lined ? borderLined : borderPixel)
+				: (lined ? scanLine    : 0);
+		}
+	}
+
+	overlay = SDL_CreateTexture(
+		renderer,
+		SDL_PIXELFORMAT_ARGB8888,
+		SDL_TEXTUREACCESS_STATIC,
+		W, H
+	);
+
+	if (!overlay) {
+		throw std::runtime_error(SDL_GetError());
+	}
+
+	SDL_SetTextureScaleMode(overlay, SDL_SCALEMODE_NEAREST);
+	SDL_SetTextureBlendMode(overlay, SDL_BLENDMODE_BLEND);
+	SDL_UpdateTexture(overlay, nullptr, pixels.data(), W * 4);
 }
 
 void BasicVideoSpec::multiplyWindowDimensions() {
@@ -161,22 +298,23 @@ void BasicVideoSpec::multiplyWindowDimensions() {
 
 void BasicVideoSpec::changeFrameMultiplier(const s32 delta) {
 	frameMultiplier = std::clamp(frameMultiplier + delta, 1, 8);
+	if (headless) { return; }
 	multiplyWindowDimensions();
+	presentPending = true;
 }
 
 void BasicVideoSpec::renderPresent() {
+	if (headless) { return; }
+	if (frames.update()) {
+		uploadFrame(frames.front());
+	}
+	if (presentOnChange && !presentPending) { return; }
+	presentPending = false;
+
 	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
 	SDL_RenderClear(renderer);
 
 	if (texture) {
-		SDL_SetRenderDrawColor(
-			renderer,
-			static_cast<u8>(frameFullColor[enableBuzzGlow] >> 16),
-			static_cast<u8>(frameFullColor[enableBuzzGlow] >>  8),
-			static_cast<u8>(frameFullColor[enableBuzzGlow]), 255
-		);
-		SDL_RenderFillRect(renderer, &frameFull);
-
 		SDL_SetRenderDrawColor(
 			renderer,
 			static_cast<u8>(frameGameColor >> 16),
@@ -188,18 +326,14 @@ void BasicVideoSpec::renderPresent() {
 		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
 		SDL_RenderTexture(renderer, texture, nullptr, &frameGame);
 
-		if (enableScanLine) {
-			SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-			SDL_SetRenderDrawColor(renderer, 0, 0, 0, 32);
-
-			const auto drawLimit{ static_cast<s32>(frameFull.h) };
-			for (auto y{ 0 }; y < drawLimit; y += perimeterWidth) {
-				SDL_RenderLine(
-					renderer,
-					frameFull.x, static_cast<f32>(y),
-					frameFull.w, static_cast<f32>(y)
-				);
-			}
+		if (overlay) {
+			SDL_SetTextureColorMod(
+				overlay,
+				static_cast<u8>(frameFullColor[enableBuzzGlow] >> 16),
+				static_cast<u8>(frameFullColor[enableBuzzGlow] >>  8),
+				static_cast<u8>(frameFullColor[enableBuzzGlow])
+			);
+			SDL_RenderTexture(renderer, overlay, nullptr, &frameFull);
 		}
 	} else {
 		SDL_RenderTexture(renderer, nullptr, nullptr, nullptr);
@@ -213,6 +347,13 @@ void BasicVideoSpec::quitTexture() noexcept {
 		SDL_DestroyTexture(texture);
 		texture = nullptr;
 	}
+	textureW = textureH = 0;
+}
+void BasicVideoSpec::quitOverlay() noexcept {
+	if (overlay) {
+		SDL_DestroyTexture(overlay);
+		overlay = nullptr;
+	}
 }
 void BasicVideoSpec::quitRenderer() noexcept {
 	if (renderer) {
@@ -11,31 +11,97 @@
 #include <SDL3/SDL.h>
 #pragma warning(pop)
 
+#include <array>
 #include <string>
+#include <algorithm>
+#include <vector>
 #include <utility>
 
 #include "../Types.hpp"
+#include "../Assistants/TripleBuffer.hpp"
+
+/*
+	The core draws into a staged frame in memory, on whichever thread runs
+	it, and publishFrame() hands a copy over to the thread presenting them.
+	renderPresent() uploads the newest frame handed over to the texture and
+	applies the size, aspect and colors it was drawn with, so only that one
+	thread ever touches the window or renderer while a core runs.
+
+	Cores say which rows they changed as they lock the texture, and every
+	frame handed over carries the rows changed by the last few frames, so
+	the texture is only sent the rows changed since it was last uploaded.
+*/
 
 class BasicVideoSpec final {
 	SDL_Window*   window{};
 	SDL_Renderer* renderer{};
 	SDL_Texture*  texture{};
+	SDL_Texture*  overlay{}; // border and scanlines, tinted the border color when drawn
+
+	using PixelFormat = decltype(SDL_PIXELFORMAT_ARGB8888);
+
+	// Rows first..last of the texture, none if last < first
+	struct RowSpan final {
+		s32 first{}, last{ -1 };
+
+		bool empty() const noexcept { return last < first; }
+		void merge(const RowSpan other) noexcept {
+			if (other.empty()) { return; }
+			if (empty()) { *this = other; return; }
+			first = std::min(first, other.first);
+			last  = std::max(last,  other.last);
+		}
+	};
+
+	static constexpr u32 cRowHistory{ 8 };
+
+	struct Frame final {
+		std::vector<u32> pixels{};
+		s32 texture_W{}, texture_H{};
+		s32 aspect_W{},  aspect_H{}, aspect_P{};
+		u32 backColor{};
+		u32 frameColor[2]{};
+		u8  alpha{ 0xFF };
+
+		u32 serial{}; // frames published up to and including this one
+		std::array<RowSpan, cRowHistory>
+			changed{}; // rows changed by each of the latest frames, by serial
+
+		// Rows changed by the frames published after the given one
+		RowSpan changedSince(u32) const noexcept;
+	};
+
+	Frame   staged{};     // drawn to by the core, also the texture when headless
+	RowSpan stagedRows{}; // rows of it changed since it was last published
+	TripleBuffer<Frame>
+		frames{};    // staged copies on their way to the presenting thread
+
+	bool headless{};
+
+	s32  textureW{}, textureH{};
+	s32  aspectW{},  aspectH{}, aspectP{};
+
+	PixelFormat textureFormat{ SDL_PIXELFORMAT_ARGB8888 };
+	u32  uploadedSerial{}; // frame the texture was last uploaded from
 
-	s32  ppitch{};
 	bool enableBuzzGlow{};
 	bool enableScanLine{};
 
+	bool presentOnChange{}; // skip presenting frames that look the same as the last
+	bool presentPending{ true };
+
 	SDL_FRect frameGame{};
 	SDL_FRect frameFull{};
 
 	u32  frameGameColor{};
 	u32  frameFullColor[2]{};
+	u8   textureAlpha{ 0xFF };
 
 	s32  perimeterWidth{};
 	s32  frameMultiplier{ 2 };
 
 public:
-	explicit BasicVideoSpec();
+	explicit BasicVideoSpec(const bool noWindow = false);
 	~BasicVideoSpec();
 
 	static bool showErrorBoxSDL(std::string_view);
@@ -44,15 +110,15 @@ public:
 	void setBackColor (
 		const u32 color
 	) noexcept {
-		frameGameColor = color;
+		staged.backColor = color;
 	}
 
 	void setFrameColor(
 		const u32 color_off,
 		const u32 color_on
 	) noexcept {
-		frameFullColor[0] = color_off;
-		frameFullColor[1] = color_on;
+		staged.frameColor[0] = color_off;
+		staged.frameColor[1] = color_on;
 	}
 
 
@@ -68,14 +134,31 @@ public:
 	void resetWindow();
 	void renderPresent();
 
+	[[nodiscard]]
+	bool isPresentOnChange() const noexcept { return presentOnChange; }
+	void isPresentOnChange(const bool state) noexcept { presentOnChange = state; presentPending = true; }
+	// Present the next frame even if nothing in it changed, e.g. once the window was exposed
+	void requestPresent() noexcept { presentPending = true; }
+
+	// Pixels of the staged frame, all rows counting as changed
 	[[nodiscard]]
 	u32* lockTexture();
+	// Pixels of the staged frame from row first on, only first..last counting as changed
+	[[nodiscard]]
+	u32* lockTextureRows(s32 first, s32 last);
 	void unlockTexture();
+	void publishFrame();
+
+	[[nodiscard]]
+	const auto& headlessPixels() const noexcept { return staged.pixels; }
 
 	void setTextureAlpha(usz);
 	void setAspectRatio(s32, s32, s32);
 
 private:
+	void uploadFrame(const Frame&);
+	void applyAspectRatio(s32, s32, s32);
+	void buildOverlay();
 	void multiplyWindowDimensions();
 
 public:
@@ -85,4 +168,5 @@ private:
 	void quitWindow() noexcept;
 	void quitRenderer() noexcept;
 	void quitTexture() noexcept;
+	void quitOverlay() noexcept;
 };
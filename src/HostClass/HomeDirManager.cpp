@@ -5,6 +5,7 @@
 */
 
 #include <fstream>
+#include <algorithm>
 
 #include "HomeDirManager.hpp"
 #include "../Assistants/BasicLogger.hpp"
@@ -40,11 +41,17 @@ void HomeDirManager::addDirectory() {
 	if (!std::filesystem::exists(permRegs)) {
 		throw PathException("Could not create subdir: ", permRegs);
 	}
+
+	saveStates = getHome() / "saveStates";
+	std::filesystem::create_directories(saveStates);
+	if (!std::filesystem::exists(saveStates)) {
+		throw PathException("Could not create subdir: ", saveStates);
+	}
 }
 
 bool HomeDirManager::verifyFile(
 	bool(*validate)(std::uint64_t fsize, std::string_view type, std::string_view sha1),
-	const char* filepath
+	const char* filepath, const std::string* knownSHA1
 ) {
 	if (!filepath) { return false; }
 	namespace fs = std::filesystem;
@@ -78,9 +85,15 @@ bool HomeDirManager::verifyFile(
 		return false;
 	}
 
+	const auto fileTime{ fs::last_write_time(fspath, error) };
+	if (error) {
+		blog.dbgLogOut("Unable to access file: " + fspath.string());
+		return false;
+	}
+
 	auto tempPath{ fspath.string() };
 	auto tempType{ fspath.extension().string() };
-	auto tempSHA1{ SHA1::from_file(tempPath) };
+	auto tempSHA1{ knownSHA1 ? *knownSHA1 : fetchSHA1(tempPath, fileSize, fileTime) };
 
 	const bool result{ validate(fileSize, tempType, tempSHA1) };
 
@@ -95,3 +108,33 @@ bool HomeDirManager::verifyFile(
 
 	return result;
 }
+
+std::string HomeDirManager::fetchSHA1(
+	const std::string& filepath,
+	const std::uint64_t filesize,
+	const std::filesystem::file_time_type filetime
+) {
+	const auto known{ std::find_if(knownFiles.begin(), knownFiles.end(),
+		[&](const KnownFile& entry) noexcept { return entry.path == filepath; }
+	) };
+
+	if (known != knownFiles.end()) {
+		std::rotate(knownFiles.begin(), known, known + 1);
+		auto& entry{ knownFiles.front() };
+
+		if (entry.size != filesize || entry.time != filetime) {
+			entry.size = filesize;
+			entry.time = filetime;
+			entry.sha1 = SHA1::from_file(filepath);
+		}
+		return entry.sha1;
+	}
+
+	knownFiles.insert(knownFiles.begin(), {
+		filepath, filesize, filetime, SHA1::from_file(filepath)
+	});
+	if (knownFiles.size() > cKnownFiles) {
+		knownFiles.pop_back();
+	}
+	return knownFiles.front().sha1;
+}
@@ -8,13 +8,29 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <filesystem>
 
 #include "../Assistants/BasicHome.hpp"
 
 class HomeDirManager final : public BasicHome {
+	// Files verified recently, their SHA1 is reused while size and write time match
+	struct KnownFile final {
+		std::string   path{};
+		std::uint64_t size{};
+		std::filesystem::file_time_type time{};
+		std::string   sha1{};
+	};
+
+	static constexpr std::size_t cKnownFiles{ 8 };
+
+	std::vector<KnownFile> knownFiles{}; // most recent first
+
+	std::string fetchSHA1(const std::string&, std::uint64_t, std::filesystem::file_time_type);
+
 public:
 	std::filesystem::path permRegs{};
+	std::filesystem::path saveStates{};
 	std::string   path{};
 	std::string   file{};
 	std::string   name{};
@@ -26,8 +42,9 @@ public:
 
 	void reset() noexcept;
 	void addDirectory();
+	// Check given file with given validator, hashing it unless its SHA1 is passed in
 	bool verifyFile(
 		bool(*)(std::uint64_t, std::string_view, std::string_view),
-		const char*
+		const char*, const std::string* = nullptr
 	);
 };
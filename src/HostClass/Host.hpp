@@ -6,6 +6,17 @@
 
 #pragma once
 
+#include <SDL3/SDL_scancode.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <stop_token>
+
+#include "../Types.hpp"
+#include "../Assistants/SPSCQueue.hpp"
+#include "../Assistants/ThreadTuning.hpp"
+
 class HomeDirManager;
 class BasicVideoSpec;
 class BasicAudioSpec;
@@ -13,18 +24,69 @@ class BasicAudioSpec;
 class FrameLimiter;
 class VM_Guest;
 
+/*
+	The guest runs on a thread of its own while a rom is loaded. The main
+	thread polls events, hands it the keyboard and any requests through a
+	queue once per frame presented, and presents the newest frame it has
+	published; the guest is only touched from the main thread while its
+	thread is stopped, which is how roms get loaded.
+*/
+
 class VM_Host final {
 	bool _doBench{};
 	s32  _cycles{};
 
+	bool _fastForward{};
+	u32  _hostTicks{}; // host frames passed since the speed was last shown
+	s32  _shownCPF{};  // cycles per frame last put in the title in bench mode
+
 	HomeDirManager& HDM;
 	BasicVideoSpec& BVS;
 	BasicAudioSpec& BAS;
 
+	// Things the guest thread does between frames on behalf of the host
+	enum Request : u32 {
+		SAVE_STATE = 1 << 0,
+		LOAD_STATE = 1 << 1,
+		AHEAD_LESS = 1 << 2,
+		AHEAD_MORE = 1 << 3,
+		CPF_LESS   = 1 << 4,
+		CPF_MORE   = 1 << 5,
+		STOP_GUEST = 1 << 6,
+		RUN_GUEST  = 1 << 7,
+	};
+
+	// What the host hands the guest thread every frame it presents
+	struct HostInput final {
+		std::array<u8, SDL_NUM_SCANCODES> keys{};
+		u32  requests{};
+		bool doBench{};
+		bool fastForward{};
+		bool rewinding{};
+	};
+
+	SPSCQueue<HostInput, 16>
+		 _inputs{};
+	u32  _requests{}; // raised but not queued yet, the queue being full
+
+	std::jthread _guestThread{};
+	ThreadTuning _guestTuning{};
+	std::atomic<u32> _framesRun{}; // guest frames run since the speed was last shown
+	std::atomic<s32> _guestCPF{};
+	std::atomic<u32> _framesLate{}; // paced frames that missed their deadline
+
 	[[nodiscard]]
 	bool doBench() const noexcept;
 	void doBench(bool) noexcept;
 
+	void fastForward(bool);
+	void showSpeed();
+
+	void startGuest(VM_Guest&, const FrameLimiter&);
+	void stopGuest();
+	void runGuest(std::stop_token, VM_Guest&, FrameLimiter);
+	void queueInput();
+
 	void prepareGuest(VM_Guest&, FrameLimiter&);
 	bool eventLoopSDL(VM_Guest&, FrameLimiter&);
 
@@ -37,5 +99,8 @@ public:
 	);
 	~VM_Host();
 
+	// Pinning and scheduling of the guest thread, applied each time it starts
+	void tuneGuestThread(const ThreadTuning& tuning) noexcept { _guestTuning = tuning; }
+
 	bool runHost();
 };
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <algorithm>
 
 #include "HomeDirManager.hpp"
 #include "BasicVideoSpec.hpp"
@@ -46,6 +47,182 @@ VM_Host::VM_Host(
 bool VM_Host::doBench() const noexcept { return _doBench; }
 void VM_Host::doBench(const bool state) noexcept { _doBench = state; }
 
+void VM_Host::fastForward(const bool state) {
+	_fastForward = state;
+	_hostTicks = 0;
+	_framesRun.store(0, std::memory_order_relaxed);
+	// assume some speedup until the first measurement so audio is capped right away
+	BAS.setSpeed(state ? 2.0f : 1.0f);
+	if (!doBench()) { BVS.changeTitle(HDM.file.c_str()); }
+}
+
+void VM_Host::showSpeed() {
+	static constexpr u32 ticksShown{ 30 };
+	if (++_hostTicks < ticksShown) { return; }
+
+	const auto framesRun{ _framesRun.exchange(0, std::memory_order_relaxed) };
+	const auto tenths{ framesRun * 10 / _hostTicks };
+	BAS.setSpeed(framesRun * 1.0f / _hostTicks);
+	_hostTicks = 0;
+	if (doBench()) { return; }
+
+	static constexpr const char* policy[]{ "drop", "pitch", "decimate" };
+	BVS.changeTitle(HDM.file + " :: x" + std::to_string(tenths / 10) + "."
+		+ std::to_string(tenths % 10) + " (" + policy[static_cast<s32>(BAS.getFastAudio())] + ")");
+}
+
+void VM_Host::startGuest(VM_Guest& Guest, const FrameLimiter& Frame) {
+	_guestCPF.store(Guest.fetchCPF(), std::memory_order_relaxed);
+	_guestThread = std::jthread{
+		[this, &Guest, Frame](const std::stop_token stop) {
+			runGuest(stop, Guest, Frame);
+		}
+	};
+}
+
+void VM_Host::stopGuest() {
+	if (_guestThread.joinable()) {
+		_guestThread.request_stop();
+		_guestThread.join();
+	}
+	for (HostInput stale; _inputs.pop(stale);) {}
+}
+
+void VM_Host::queueInput() {
+	using namespace bic;
+
+	HostInput input;
+	std::copy_n(SDL_GetKeyboardState(nullptr), input.keys.size(), input.keys.data());
+	input.requests    = _requests;
+	input.doBench     = doBench();
+	input.fastForward = _fastForward;
+	input.rewinding   = kb.isHeld(KEY(F1));
+
+	if (_inputs.push(std::move(input))) { _requests = 0; }
+}
+
+void VM_Host::runGuest(const std::stop_token stop, VM_Guest& Guest, FrameLimiter Frame) {
+	HostInput input{};
+	bool benchShown{};
+
+	_guestTuning.applyToThisThread("guest");
+	Guest.useKeySource(input.keys.data());
+
+	while (!stop.stop_requested()) {
+		// fast-forward runs frames back to back, the host presents the newest
+		if (!input.fastForward) {
+			if (!Frame.checkTime()) { continue; }
+			if (!Frame.isKeepingPace()) {
+				_framesLate.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		u32 requests{};
+		for (HostInput next; _inputs.pop(next);) {
+			requests |= next.requests;
+			input = std::move(next);
+		}
+
+		if (input.doBench != benchShown) {
+			benchShown = input.doBench;
+			if (benchShown) {
+				std::cout << "\33[1;1H\33[2J\33[?25l"
+					<< "Cycle time:      ms |     μs"
+					<< "\nelapsed since last: "
+					<< "\nidle frames:        "
+					<< "\nidle cycles:        "
+					<< "\nsave state:                μs"
+					<< "\nload state:                μs"
+					<< "\nrewind capture:            ns"
+					<< "\nrewind frames:             KB"
+					<< "\nrun ahead frames:   "
+					<< "\nrun ahead cost:            μs"
+					<< "\naudio queued:              smp"
+					<< "\naudio underruns:    "
+					<< "\nframes late:        ";
+			}
+		}
+
+		if (requests & STOP_GUEST) { Guest.isSystemStopped(true);  }
+		if (requests & RUN_GUEST)  { Guest.isSystemStopped(false); }
+
+		if (requests & SAVE_STATE) {
+			const auto timeStart{ std::chrono::steady_clock::now() };
+			const auto saved{ Guest.saveState() };
+			const auto micros{ std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - timeStart).count() };
+
+			if (benchShown && saved) {
+				std::cout << "\33[5;21H" << std::setw(6) << micros;
+			}
+		}
+		if (requests & LOAD_STATE) {
+			const auto timeStart{ std::chrono::steady_clock::now() };
+			const auto loaded{ Guest.loadState() };
+			const auto micros{ std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - timeStart).count() };
+
+			if (benchShown && loaded) {
+				std::cout << "\33[6;21H" << std::setw(6) << micros;
+			}
+		}
+
+		if (requests & AHEAD_LESS) { Guest.changeRunAhead(-1); }
+		if (requests & AHEAD_MORE) { Guest.changeRunAhead(+1); }
+
+		if (requests & CPF_LESS) { Guest.changeCPF(-50'000); }
+		if (requests & CPF_MORE) { Guest.changeCPF(+50'000); }
+
+		if (input.rewinding) {
+			Guest.rewindFrame();
+		} else if (benchShown) {
+			Guest.processFrame();
+
+			const auto timeStart{ std::chrono::steady_clock::now() };
+			Guest.captureRewind();
+			const auto nanos{ std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - timeStart).count() };
+
+			std::cout << "\33[7;21H" << std::setw(6) << nanos;
+
+			const auto aheadStart{ std::chrono::steady_clock::now() };
+			Guest.runAhead();
+			const auto aheadMicros{ std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - aheadStart).count() };
+
+			std::cout << "\33[10;21H" << std::setw(6) << aheadMicros;
+		} else {
+			Guest.processFrame();
+			Guest.captureRewind();
+			Guest.runAhead();
+		}
+
+		if (benchShown) {
+			std::cout << "\33[8;17H" << std::setw(5) << Guest.getRewindFrames();
+			std::cout << "\33[8;23H" << std::setw(5) << Guest.getRewindBytes() / 1024;
+			std::cout << "\33[9;21H" << Guest.getRunAhead();
+
+			const auto micros{ Frame.getElapsedMicrosSince()};
+			std::cout << "\33[2;21H" << Frame.getElapsedMillisLast();
+			std::cout << "\33[1;13H" << std::setw(4) << micros / 1000;
+			std::cout << "\33[1;23H" << std::setw(3) << micros % 1000;
+			std::cout << "\33[3;21H" << Guest.getIdleFrames();
+			std::cout << "\33[4;21H" << Guest.getIdleCycles();
+
+			const auto audio{ BAS.getStats() };
+			std::cout << "\33[11;21H" << std::setw(6) << audio.queued;
+			std::cout << "\33[12;21H" << audio.underruns;
+			std::cout << "\33[13;21H" << _framesLate.load(std::memory_order_relaxed);
+		}
+
+		_guestCPF.store(Guest.fetchCPF(), std::memory_order_relaxed);
+		_framesRun.fetch_add(1, std::memory_order_relaxed);
+		BVS.publishFrame();
+	}
+
+	Guest.useKeySource(nullptr);
+}
+
 
 bool VM_Host::runHost() {
 	FrameLimiter Frame;
@@ -59,6 +236,7 @@ bool VM_Host::runHost() {
 		if (!Frame.checkTime()) { continue; }
 
 		if (eventLoopSDL(Guest, Frame)) {
+			stopGuest();
 			return EXIT_SUCCESS;
 		}
 
@@ -68,9 +246,13 @@ bool VM_Host::runHost() {
 		if (kb.isPressed(KEY(LEFT))) {
 			BAS.changeVolume(-15);
 		}
+		if (kb.isPressed(KEY(F8))) {
+			BVS.isPresentOnChange(!BVS.isPresentOnChange());
+		}
 
 		if (GameFileChecker::hasCore()) {
 			if (kb.isPressed(KEY(ESCAPE))) {
+				stopGuest();
 				BVS.resetWindow();
 				GameFileChecker::delCore();
 				prepareGuest(Guest, Frame);
@@ -86,13 +268,24 @@ bool VM_Host::runHost() {
 					BVS.changeTitle(HDM.file.c_str());
 				} else {
 					doBench(true);
-					BVS.changeTitle(std::to_string(Guest.fetchCPF()));
-					std::cout << "\33[1;1H\33[2J\33[?25l"
-						<< "Cycle time:      ms |     μs"
-						<< "\nelapsed since last: ";
+					_shownCPF = _guestCPF.load(std::memory_order_relaxed);
+					BVS.changeTitle(std::to_string(_shownCPF));
 				}
 			}
 
+			if (kb.isPressed(KEY(F5))) { _requests |= SAVE_STATE; }
+			if (kb.isPressed(KEY(F9))) { _requests |= LOAD_STATE; }
+
+			if (kb.isPressed(KEY(TAB))) {
+				fastForward(!_fastForward);
+			}
+			if (kb.isPressed(KEY(F4))) {
+				BAS.cycleFastAudio();
+			}
+
+			if (kb.isPressed(KEY(F2))) { _requests |= AHEAD_LESS; }
+			if (kb.isPressed(KEY(F3))) { _requests |= AHEAD_MORE; }
+
 			if (kb.isPressed(KEY(PAGEDOWN))) {
 				BVS.changeFrameMultiplier(-1);
 			}
@@ -101,21 +294,21 @@ bool VM_Host::runHost() {
 			}
 
 			if (doBench()) {
-				if (kb.isPressed(KEY(UP))) {
-					BVS.changeTitle(std::to_string(Guest.changeCPF(+50'000)));
-				}
-				if (kb.isPressed(KEY(DOWN))) {
-					BVS.changeTitle(std::to_string(Guest.changeCPF(-50'000)));
+				if (kb.isPressed(KEY(UP)))   { _requests |= CPF_MORE; }
+				if (kb.isPressed(KEY(DOWN))) { _requests |= CPF_LESS; }
+
+				const auto guestCPF{ _guestCPF.load(std::memory_order_relaxed) };
+				if (guestCPF != _shownCPF) {
+					_shownCPF = guestCPF;
+					BVS.changeTitle(std::to_string(_shownCPF));
 				}
+			}
 
-				Guest.processFrame();
+			queueInput();
 
-				const auto micros{ Frame.getElapsedMicrosSince()};
-				std::cout << "\33[2;21H" << Frame.getElapsedMillisLast();
-				std::cout << "\33[1;13H" << std::setw(4) << micros / 1000;
-				std::cout << "\33[1;23H" << std::setw(3) << micros % 1000;
-					
-			} else { Guest.processFrame(); }
+			if (_fastForward) {
+				showSpeed();
+			}
 		} else {
 			if (kb.isPressed(KEY(ESCAPE))) {
 				return EXIT_SUCCESS;
@@ -130,13 +323,20 @@ bool VM_Host::runHost() {
 }
 
 void VM_Host::prepareGuest(VM_Guest& Guest, FrameLimiter& Frame) {
+	stopGuest();
+
 	bic::kb.updateCopy();
 	bic::mb.updateCopy();
 
+	_fastForward = false;
+	_requests    = 0;
+	BAS.setSpeed(1.0f);
+
 	if (GameFileChecker::hasCore()) {
 		Guest.initGameCore(HDM, BVS, BAS);
 		Frame.setLimiter(Guest.fetchFramerate());
 		BVS.changeTitle(HDM.file.c_str());
+		startGuest(Guest, Frame);
 	} else {
 		Frame.setLimiter(30.0f);
 		HDM.reset();
@@ -162,11 +362,18 @@ bool VM_Host::eventLoopSDL(VM_Guest& Guest, FrameLimiter& Frame) {
 				break;
 
 			case SDL_EVENT_WINDOW_MINIMIZED:
-				Guest.isSystemStopped(true);
+				_requests |= STOP_GUEST;
 				break;
 
 			case SDL_EVENT_WINDOW_RESTORED:
-				Guest.isSystemStopped(false);
+				_requests |= RUN_GUEST;
+				BVS.requestPresent();
+				break;
+
+			case SDL_EVENT_WINDOW_EXPOSED:
+			case SDL_EVENT_WINDOW_RESIZED:
+			case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+				BVS.requestPresent();
 				break;
 		}
 	}